@@ -96,6 +96,10 @@ using __STD::push_heap;
 using __STD::pop_heap;
 using __STD::make_heap;
 using __STD::sort_heap;
+using __STD::push_dary_heap;
+using __STD::pop_dary_heap;
+using __STD::make_dary_heap;
+using __STD::sort_dary_heap;
 
 // Names from <stl_numeric.h>
 using __STD::accumulate; 
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 1997
+ * Silicon Graphics Computer Systems, Inc.
+ *
+ * Permission to use, copy, modify, distribute and sell this software
+ * and its documentation for any purpose is hereby granted without fee,
+ * provided that the above copyright notice appear in all copies and
+ * that both that copyright notice and this permission notice appear
+ * in supporting documentation.  Silicon Graphics makes no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ */
+
+#ifndef __SGI_STL_FLAT_MAP_H
+#define __SGI_STL_FLAT_MAP_H
+
+#include <algobase.h>
+#include <alloc.h>
+#include <stl_flat_tree.h>
+#include <stl_flat_map.h>
+
+#ifdef __STL_USE_NAMESPACES
+using __STD::flat_map;
+#endif /* __STL_USE_NAMESPACES */
+
+#endif /* __SGI_STL_FLAT_MAP_H */
+
+// Local Variables:
+// mode:C++
+// End:
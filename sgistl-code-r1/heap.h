@@ -35,6 +35,10 @@ using __STD::push_heap;
 using __STD::pop_heap;
 using __STD::make_heap;
 using __STD::sort_heap;
+using __STD::push_dary_heap;
+using __STD::pop_dary_heap;
+using __STD::make_dary_heap;
+using __STD::sort_dary_heap;
 
 #endif /* __STL_USE_NAMESPACES */
 
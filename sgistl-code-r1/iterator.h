@@ -91,6 +91,7 @@ using __STD::ostream_iterator;
 // Names from stl_construct.h
 using __STD::construct;
 using __STD::destroy;
+using __STD::default_init_t;
 
 // Names from stl_raw_storage_iter.h
 using __STD::raw_storage_iterator;
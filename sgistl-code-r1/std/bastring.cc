@@ -225,6 +225,22 @@ resize (size_type n, charT c)
     erase (n);
 }
 
+// The characters past the old length are left as they are.
+template <class charT, class traits, class Allocator>
+void basic_string <charT, traits, Allocator>::
+resize_default_init (size_type n)
+{
+  LENGTHERROR (n > max_size ());
+
+  if (n > length ())
+    {
+      alloc (n, true);
+      rep ()->len = n;
+    }
+  else
+    erase (n);
+}
+
 template <class charT, class traits, class Allocator>
 basic_string <charT, traits, Allocator>::size_type
 basic_string <charT, traits, Allocator>::
@@ -37,6 +37,7 @@
 
 // NOTE : This does NOT conform to the draft standard and is likely to change
 #include <alloc.h>
+#include <stl_construct.h>
 
 extern "C++" {
 class istream; class ostream;
@@ -144,6 +145,8 @@ public:
     : dat (nilRep.grab ()) { assign (s); }
   basic_string (size_type n, charT c)
     : dat (nilRep.grab ()) { assign (n, c); }
+  basic_string (size_type n, default_init_t)
+    : dat (nilRep.grab ()) { resize_default_init (n); }
 #ifdef __STL_MEMBER_TEMPLATES
   template<class InputIterator>
     basic_string(InputIterator begin, InputIterator end)
@@ -302,6 +305,7 @@ public:
   void resize (size_type n, charT c);
   void resize (size_type n)
     { resize (n, eos ()); }
+  void resize_default_init (size_type n);
   void reserve (size_type) { }
 
   size_type copy (charT* s, size_type n, size_type pos = 0) const;
@@ -613,6 +617,14 @@ operator<< (ostream&, const basic_string <charT, traits, Allocator>&);
 template <class charT, class traits, class Allocator> istream&
 getline (istream&, basic_string <charT, traits, Allocator>&, charT delim = '\n');
 
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+// The string itself holds only a pointer into its shared representation.
+template <class charT, class traits, class Allocator>
+struct __relocate_traits<basic_string <charT, traits, Allocator> > {
+  typedef __true_type is_trivially_relocatable;
+};
+#endif
+
 } // extern "C++"
 
 #include <std/bastring.cc>
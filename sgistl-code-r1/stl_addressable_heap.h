@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 1997
+ * Silicon Graphics Computer Systems, Inc.
+ *
+ * Permission to use, copy, modify, distribute and sell this software
+ * and its documentation for any purpose is hereby granted without fee,
+ * provided that the above copyright notice appear in all copies and
+ * that both that copyright notice and this permission notice appear
+ * in supporting documentation.  Silicon Graphics makes no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ */
+
+/* NOTE: This is an internal header file, included by other STL headers.
+ *   You should not attempt to use it directly.
+ */
+
+#ifndef __SGI_STL_INTERNAL_ADDRESSABLE_HEAP_H
+#define __SGI_STL_INTERNAL_ADDRESSABLE_HEAP_H
+
+/*
+
+Priority queue whose elements can be changed or removed after they are
+pushed.
+
+push() returns a handle to the new element that stays valid until the
+element is popped or erased.  Through it the element can be read or
+modified with value(); update() restores the heap order after the
+element has changed in either direction, and erase() removes it.  This
+is what shortest-path searches and timer queues want in place of
+pushing duplicates onto a priority_queue and skipping the stale ones.
+
+Each element lives in its own node, which records where it sits in the
+heap.  The heap itself is a vector of entries pointing to the nodes,
+arranged by the d-ary heap functions of stl_heap.h with the given
+Arity.  An entry that is assigned to a heap position stores that
+position in its node, so the sift loops there keep every node's
+position current without knowing about them.  When the vector grows the
+positions are all recomputed.
+
+The comparison must not throw.  An addressable_heap cannot be copied,
+since its handles would not carry over to the copy.
+
+*/
+
+#include <stl_algobase.h>
+#include <stl_alloc.h>
+#include <stl_construct.h>
+#include <stl_uninitialized.h>
+#include <stl_function.h>
+#include <stl_vector.h>
+#include <stl_heap.h>
+
+__STL_BEGIN_NAMESPACE
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma set woff 1174
+#endif
+
+template <class T>
+struct __addressable_heap_node;
+
+template <class T>
+struct __addressable_heap_entry {
+  __addressable_heap_node<T>* node;
+
+  __addressable_heap_entry(__addressable_heap_node<T>* p) : node(p) {}
+  __addressable_heap_entry(const __addressable_heap_entry<T>& x)
+    : node(x.node) {}
+  __addressable_heap_entry<T>&
+  operator=(const __addressable_heap_entry<T>& x) {
+    node = x.node;
+    node->entry = this;
+    return *this;
+  }
+};
+
+template <class T>
+struct __addressable_heap_node {
+  T value;
+  __addressable_heap_entry<T>* entry;   // its position in the heap
+};
+
+template <class T, class Compare>
+struct __addressable_heap_compare {
+  Compare comp;
+  __addressable_heap_compare(const Compare& c) : comp(c) {}
+  bool operator()(const __addressable_heap_entry<T>& x,
+                  const __addressable_heap_entry<T>& y) const {
+    return comp(x.node->value, y.node->value);
+  }
+};
+
+#ifndef __STL_LIMITED_DEFAULT_TEMPLATES
+template <class T, class Compare = less<T>, size_t Arity = 4,
+          class Alloc = alloc>
+#else
+template <class T, class Compare, size_t Arity = 4, class Alloc = alloc>
+#endif
+class addressable_heap {
+public:
+  typedef T value_type;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef size_t size_type;
+  typedef __addressable_heap_node<T>* handle;
+
+protected:
+  typedef __addressable_heap_node<T> node;
+  typedef __addressable_heap_entry<T> entry;
+  typedef __addressable_heap_compare<T, Compare> entry_compare;
+  typedef simple_alloc<node, Alloc> node_allocator;
+  typedef vector<entry, Alloc> heap_type;
+  typedef typename heap_type::difference_type difference_type;
+
+  heap_type c;
+  entry_compare comp;
+
+  handle create_node(const T& x) {
+    handle p = node_allocator::allocate();
+    __STL_TRY {
+      construct(&p->value, x);
+    }
+    __STL_UNWIND(node_allocator::deallocate(p));
+    return p;
+  }
+  void destroy_node(handle p) {
+    destroy(&p->value);
+    node_allocator::deallocate(p);
+  }
+  void relink() {
+    for (typename heap_type::iterator i = c.begin(); i != c.end(); ++i)
+      i->node->entry = &*i;
+  }
+  difference_type index(handle h) const { return h->entry - &*c.begin(); }
+
+  // Puts e into the hole at i, in a heap of len entries, and moves it up
+  // or down to where it belongs.
+  void fill_hole(difference_type i, difference_type len, entry e) {
+    if (i > 0 && comp(c[(i - 1) / difference_type(Arity)], e))
+      __dary_push_heap<Arity>(c.begin(), i, difference_type(0), e, comp);
+    else
+      __dary_adjust_heap<Arity>(c.begin(), i, len, e, comp);
+  }
+
+private:
+  addressable_heap(const addressable_heap<T, Compare, Arity, Alloc>&);
+  addressable_heap<T, Compare, Arity, Alloc>&
+  operator=(const addressable_heap<T, Compare, Arity, Alloc>&);
+
+public:
+  addressable_heap() : comp(Compare()) {}
+  explicit addressable_heap(const Compare& x) : comp(x) {}
+  ~addressable_heap() { clear(); }
+
+  bool empty() const { return c.empty(); }
+  size_type size() const { return c.size(); }
+  Compare value_comp() const { return comp.comp; }
+
+  const_reference top() const { return c.front().node->value; }
+  handle top_handle() const { return c.front().node; }
+  static reference value(handle h) { return h->value; }
+
+  handle push(const T& x);
+  void pop() { erase(top_handle()); }
+  // Restores the heap after value(h) has been changed.
+  void update(handle h) { fill_hole(index(h), c.size(), entry(h)); }
+  void update(handle h, const T& x) {
+    h->value = x;
+    update(h);
+  }
+  void erase(handle h) {
+    const difference_type i = index(h);
+    const difference_type last = c.size() - 1;
+    if (i != last)
+      fill_hole(i, last, c.back());
+    c.pop_back();
+    destroy_node(h);
+  }
+  void clear() {
+    for (typename heap_type::iterator i = c.begin(); i != c.end(); ++i)
+      destroy_node(i->node);
+    c.clear();
+  }
+  void reserve(size_type n) {
+    if (n > c.capacity()) {
+      c.reserve(n);
+      relink();
+    }
+  }
+  void swap(addressable_heap<T, Compare, Arity, Alloc>& x) {
+    c.swap(x.c);
+    __STD::swap(comp, x.comp);
+  }
+};
+
+template <class T, class Compare, size_t Arity, class Alloc>
+typename addressable_heap<T, Compare, Arity, Alloc>::handle
+addressable_heap<T, Compare, Arity, Alloc>::push(const T& x)
+{
+  handle p = create_node(x);
+  __STL_TRY {
+    if (c.size() == c.capacity()) {
+      c.push_back(entry(p));
+      relink();
+    }
+    else
+      c.push_back(entry(p));
+  }
+  __STL_UNWIND(destroy_node(p));
+  __dary_push_heap<Arity>(c.begin(), difference_type(c.size() - 1),
+                          difference_type(0), entry(p), comp);
+  return p;
+}
+
+#ifdef __STL_FUNCTION_TMPL_PARTIAL_ORDER
+
+template <class T, class Compare, size_t Arity, class Alloc>
+inline void swap(addressable_heap<T, Compare, Arity, Alloc>& x,
+                 addressable_heap<T, Compare, Arity, Alloc>& y) {
+  x.swap(y);
+}
+
+#endif /* __STL_FUNCTION_TMPL_PARTIAL_ORDER */
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma reset woff 1174
+#endif
+
+__STL_END_NAMESPACE
+
+#endif /* __SGI_STL_INTERNAL_ADDRESSABLE_HEAP_H */
+
+// Local Variables:
+// mode:C++
+// End:
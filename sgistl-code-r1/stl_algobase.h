@@ -281,21 +281,93 @@ copy_n(InputIterator first, Size count,
   return __copy_n(first, count, result, iterator_category(first));
 }
 
-//Ԫص뿪[first, last)
 template <class ForwardIterator, class T>
-void fill(ForwardIterator first, ForwardIterator last, const T& value) {
+struct __fill_dispatch
+{
+  void operator()(ForwardIterator first, ForwardIterator last,
+                  const T& value) {
+    for ( ; first != last; ++first)
+      *first = value;
+  }
+};
+
+template <class OutputIterator, class Size, class T>
+struct __fill_n_dispatch
+{
+  OutputIterator operator()(OutputIterator first, Size n, const T& value) {
+    for ( ; n > 0; --n, ++first)
+      *first = value;
+    return first;
+  }
+};
+
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION 
+
+// Whether every byte of x is the same, so that memset can store it.
+template <class T>
+inline bool __fill_bytes_repeat(const T& x) {
+  const unsigned char* p = (const unsigned char*) &x;
+  for (size_t i = 1; i < sizeof(T); ++i)
+    if (p[i] != p[0])
+      return false;
+  return true;
+}
+
+template <class T>
+inline void __fill_t(T* first, T* last, const T& value, __true_type) {
+  if (first == last)
+    return;
+  if (__fill_bytes_repeat(value))
+    memset(first, *(const unsigned char*) &value, sizeof(T) * (last - first));
+  else {
+    // A local copy cannot alias *first, so the compiler is free to keep
+    // it in registers and store it several elements at a time.
+    const T tmp = value;
+    for ( ; first != last; ++first)
+      *first = tmp;
+  }
+}
+
+template <class T>
+inline void __fill_t(T* first, T* last, const T& value, __false_type) {
   for ( ; first != last; ++first)
     *first = value;
 }
 
+template <class T>
+struct __fill_dispatch<T*, T>
+{
+  void operator()(T* first, T* last, const T& value) {
+    typedef typename __type_traits<T>::has_trivial_assignment_operator t; 
+    __fill_t(first, last, value, t());
+  }
+};
+
+template <class T, class Size>
+struct __fill_n_dispatch<T*, Size, T>
+{
+  T* operator()(T* first, Size n, const T& value) {
+    if (!(n > 0))
+      return first;
+    typedef typename __type_traits<T>::has_trivial_assignment_operator t; 
+    __fill_t(first, first + n, value, t());
+    return first + n;
+  }
+};
+
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
+//Ԫص뿪[first, last)
+template <class ForwardIterator, class T>
+void fill(ForwardIterator first, ForwardIterator last, const T& value) {
+  __fill_dispatch<ForwardIterator, T>()(first, last, value);
+}
+
 //nֵΪvalueԪصfirstʼ
 template <class OutputIterator, class Size, class T>
 OutputIterator fill_n(OutputIterator first, Size n, const T& value) 
 {
-  for ( ; n > 0; --n, ++first)
-    *first = value;
-  
-  return first;
+  return __fill_n_dispatch<OutputIterator, Size, T>()(first, n, value);
 }
 
 template <class InputIterator1, class InputIterator2>
@@ -40,6 +40,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#ifndef __TYPE_TRAITS_H
+#include <type_traits.h>
+#endif
 #ifndef __RESTRICT
 #  define __RESTRICT
 #endif
@@ -289,6 +292,40 @@ static void * reallocate(void *p, size_t old_sz, size_t new_sz)
 
 };
 
+// __reallocate_traits<Alloc>::has_reallocate is __true_type if Alloc has
+// a reallocate(p, old_sz, new_sz) that, like realloc, may extend the
+// block where it is or move its contents to a new one.  A container can
+// then resize storage holding trivially relocatable objects (see
+// __relocate_traits) without copying them one at a time.
+
+template <class Alloc>
+struct __reallocate_traits {
+  typedef __false_type has_reallocate;
+};
+
+// __usable_size_traits<Alloc>::usable(n) is the number of bytes a block
+// that Alloc returns for a request of n bytes can really hold, where
+// that is known; otherwise it is n.
+
+template <class Alloc>
+struct __usable_size_traits {
+  static size_t usable(size_t n) { return n; }
+};
+
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+
+template <int inst>
+struct __reallocate_traits<__malloc_alloc_template<inst> > {
+  typedef __true_type has_reallocate;
+};
+
+template <class Alloc>
+struct __reallocate_traits<debug_alloc<Alloc> > {
+  typedef typename __reallocate_traits<Alloc>::has_reallocate has_reallocate;
+};
+
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
 
 # ifdef __USE_MALLOC
 
@@ -463,6 +500,25 @@ public:
 typedef __default_alloc_template<__NODE_ALLOCATOR_THREADS, 0> alloc;
 typedef __default_alloc_template<false, 0> single_client_alloc;
 
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+
+template <bool threads, int inst>
+struct __reallocate_traits<__default_alloc_template<threads, inst> > {
+  typedef __true_type has_reallocate;
+};
+
+// Small blocks come from free lists of whole __ALIGN-byte units; larger
+// ones from malloc, whose rounding is not known here.
+template <bool threads, int inst>
+struct __usable_size_traits<__default_alloc_template<threads, inst> > {
+  enum { align = 8, max_bytes = 128 };
+  static size_t usable(size_t n) {
+    return n > (size_t) max_bytes ? n : (n + align - 1) & ~(align - 1);
+  }
+};
+
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
 
 
 /* We allocate memory in large chunks in order to avoid fragmenting     */
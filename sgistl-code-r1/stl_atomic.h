@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 1997
+ * Silicon Graphics Computer Systems, Inc.
+ *
+ * Permission to use, copy, modify, distribute and sell this software
+ * and its documentation for any purpose is hereby granted without fee,
+ * provided that the above copyright notice appear in all copies and
+ * that both that copyright notice and this permission notice appear
+ * in supporting documentation.  Silicon Graphics makes no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ */
+
+/* NOTE: This is an internal header file, included by other STL headers.
+ *   You should not attempt to use it directly.
+ */
+
+#ifndef __SGI_STL_INTERNAL_ATOMIC_H
+#define __SGI_STL_INTERNAL_ATOMIC_H
+
+/*
+
+Word-sized atomic operations for the concurrent containers.
+
+All of them act on a volatile size_t.  __stl_atomic_load is an acquire
+load and __stl_atomic_store a release store; compare-and-swap,
+fetch-and-add and __stl_atomic_fence are full barriers.
+
+GCC's builtins are used where they exist: the __atomic family, or else
+the older __sync family, whose loads and stores need explicit barriers.
+Other compilers use the primitives of the thread package, as the
+allocators do.  With plain pthreads that means a single mutex, which is
+correct but no longer lock-free; with _NOTHREADS the operations are
+ordinary loads and stores.
+
+__stl_backoff is what the blocking operations of the concurrent
+containers do while they wait: spin briefly, then yield the processor.
+
+*/
+
+#if defined(__GNUC__) && \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+#   define __STL_ATOMIC_BUILTINS
+#elif defined(__GNUC__) && __GNUC__ == 4 && __GNUC_MINOR__ >= 1
+#   define __STL_SYNC_BUILTINS
+#endif
+
+#if defined(__STL_PTHREADS) || defined(__STL_SGI_THREADS)
+#   include <sched.h>
+#endif
+
+__STL_BEGIN_NAMESPACE
+
+#if defined(__STL_ATOMIC_BUILTINS)
+
+inline size_t __stl_atomic_load(const volatile size_t* p) {
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+inline void __stl_atomic_store(volatile size_t* p, size_t x) {
+  __atomic_store_n(p, x, __ATOMIC_RELEASE);
+}
+inline bool __stl_atomic_compare_and_swap(volatile size_t* p, size_t old,
+                                          size_t x) {
+  return __atomic_compare_exchange_n(p, &old, x, false,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+inline size_t __stl_atomic_fetch_add(volatile size_t* p, size_t x) {
+  return __atomic_fetch_add(p, x, __ATOMIC_SEQ_CST);
+}
+inline void __stl_atomic_fence() { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+
+#elif defined(__STL_SYNC_BUILTINS)
+
+inline size_t __stl_atomic_load(const volatile size_t* p) {
+  size_t x = *p;
+  __sync_synchronize();
+  return x;
+}
+inline void __stl_atomic_store(volatile size_t* p, size_t x) {
+  __sync_synchronize();
+  *p = x;
+}
+inline bool __stl_atomic_compare_and_swap(volatile size_t* p, size_t old,
+                                          size_t x) {
+  return __sync_bool_compare_and_swap(p, old, x);
+}
+inline size_t __stl_atomic_fetch_add(volatile size_t* p, size_t x) {
+  return __sync_fetch_and_add(p, x);
+}
+inline void __stl_atomic_fence() { __sync_synchronize(); }
+
+#elif defined(__STL_SGI_THREADS)
+
+// The MIPSpro intrinsics, which are full barriers.
+inline size_t __stl_atomic_load(const volatile size_t* p) {
+  size_t x = *p;
+  __synchronize();
+  return x;
+}
+inline void __stl_atomic_store(volatile size_t* p, size_t x) {
+  __synchronize();
+  *p = x;
+}
+inline bool __stl_atomic_compare_and_swap(volatile size_t* p, size_t old,
+                                          size_t x) {
+  return __compare_and_swap((size_t*) p, old, x);
+}
+inline size_t __stl_atomic_fetch_add(volatile size_t* p, size_t x) {
+  return __fetch_and_add((size_t*) p, x);
+}
+inline void __stl_atomic_fence() { __synchronize(); }
+
+#elif defined(__STL_WIN32THREADS)
+
+// Loads and stores of aligned words are acquire and release on x86;
+// the Interlocked functions are full barriers.
+inline size_t __stl_atomic_load(const volatile size_t* p) { return *p; }
+inline void __stl_atomic_store(volatile size_t* p, size_t x) { *p = x; }
+// long is 32 bits even on Win64, so size_t needs the 64-bit functions
+// there.
+#ifdef _WIN64
+inline bool __stl_atomic_compare_and_swap(volatile size_t* p, size_t old,
+                                          size_t x) {
+  return InterlockedCompareExchange64((volatile LONGLONG*) p, (LONGLONG) x,
+                                      (LONGLONG) old) == (LONGLONG) old;
+}
+inline size_t __stl_atomic_fetch_add(volatile size_t* p, size_t x) {
+  return InterlockedExchangeAdd64((volatile LONGLONG*) p, (LONGLONG) x);
+}
+#else /* _WIN64 */
+inline bool __stl_atomic_compare_and_swap(volatile size_t* p, size_t old,
+                                          size_t x) {
+  return InterlockedCompareExchange((long*) p, (long) x, (long) old)
+         == (long) old;
+}
+inline size_t __stl_atomic_fetch_add(volatile size_t* p, size_t x) {
+  return InterlockedExchangeAdd((long*) p, (long) x);
+}
+#endif /* _WIN64 */
+inline void __stl_atomic_fence() {
+  long dummy;
+  InterlockedExchange(&dummy, 0);
+}
+
+#elif defined(__STL_PTHREADS)
+
+template <bool dummy>
+struct __stl_atomic_lock {
+  static pthread_mutex_t lock;
+};
+
+template <bool dummy>
+pthread_mutex_t __stl_atomic_lock<dummy>::lock = PTHREAD_MUTEX_INITIALIZER;
+
+inline size_t __stl_atomic_load(const volatile size_t* p) {
+  pthread_mutex_lock(&__stl_atomic_lock<true>::lock);
+  size_t x = *p;
+  pthread_mutex_unlock(&__stl_atomic_lock<true>::lock);
+  return x;
+}
+inline void __stl_atomic_store(volatile size_t* p, size_t x) {
+  pthread_mutex_lock(&__stl_atomic_lock<true>::lock);
+  *p = x;
+  pthread_mutex_unlock(&__stl_atomic_lock<true>::lock);
+}
+inline bool __stl_atomic_compare_and_swap(volatile size_t* p, size_t old,
+                                          size_t x) {
+  pthread_mutex_lock(&__stl_atomic_lock<true>::lock);
+  bool result = *p == old;
+  if (result)
+    *p = x;
+  pthread_mutex_unlock(&__stl_atomic_lock<true>::lock);
+  return result;
+}
+inline size_t __stl_atomic_fetch_add(volatile size_t* p, size_t x) {
+  pthread_mutex_lock(&__stl_atomic_lock<true>::lock);
+  size_t result = *p;
+  *p = result + x;
+  pthread_mutex_unlock(&__stl_atomic_lock<true>::lock);
+  return result;
+}
+inline void __stl_atomic_fence() {
+  pthread_mutex_lock(&__stl_atomic_lock<true>::lock);
+  pthread_mutex_unlock(&__stl_atomic_lock<true>::lock);
+}
+
+#else /* _NOTHREADS */
+
+inline size_t __stl_atomic_load(const volatile size_t* p) { return *p; }
+inline void __stl_atomic_store(volatile size_t* p, size_t x) { *p = x; }
+inline bool __stl_atomic_compare_and_swap(volatile size_t* p, size_t old,
+                                          size_t x) {
+  if (*p != old)
+    return false;
+  *p = x;
+  return true;
+}
+inline size_t __stl_atomic_fetch_add(volatile size_t* p, size_t x) {
+  size_t result = *p;
+  *p = result + x;
+  return result;
+}
+inline void __stl_atomic_fence() {}
+
+#endif
+
+inline void __stl_thread_yield() {
+#if defined(__STL_PTHREADS) || defined(__STL_SGI_THREADS)
+  sched_yield();
+#elif defined(__STL_WIN32THREADS)
+  Sleep(0);
+#endif
+}
+
+struct __stl_backoff {
+  enum { spin_max = 64 };
+  unsigned int spins;
+
+  __stl_backoff() : spins(0) {}
+  void operator()() {
+    if (spins < spin_max) {
+      ++spins;
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+      __asm__ __volatile__("pause");
+#endif
+    }
+    else
+      __stl_thread_yield();
+  }
+  void reset() { spins = 0; }
+};
+
+__STL_END_NAMESPACE
+
+#endif /* __SGI_STL_INTERNAL_ATOMIC_H */
+
+// Local Variables:
+// mode:C++
+// End:
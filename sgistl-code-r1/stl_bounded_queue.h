@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 1997
+ * Silicon Graphics Computer Systems, Inc.
+ *
+ * Permission to use, copy, modify, distribute and sell this software
+ * and its documentation for any purpose is hereby granted without fee,
+ * provided that the above copyright notice appear in all copies and
+ * that both that copyright notice and this permission notice appear
+ * in supporting documentation.  Silicon Graphics makes no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ */
+
+/* NOTE: This is an internal header file, included by other STL headers.
+ *   You should not attempt to use it directly.
+ */
+
+#ifndef __SGI_STL_INTERNAL_BOUNDED_QUEUE_H
+#define __SGI_STL_INTERNAL_BOUNDED_QUEUE_H
+
+/*
+
+Bounded multi-producer, multi-consumer FIFO queue.
+
+Unlike the queue adaptor, a bounded_queue may be used by any number of
+threads at once without a lock.  It is a ring of cells, each holding a
+value and a sequence number, after Vyukov.  A cell whose sequence
+equals the position of a producer is free for that producer, and one
+whose sequence is that position plus one holds the value a consumer at
+that position will take.  Producers and consumers each share a single
+position counter, which they advance with compare-and-swap, and the two
+counters are kept on cache lines of their own.  A thread that has
+claimed a cell fills or empties it and then publishes it by storing its
+next sequence number, so no thread ever waits for another except when
+the queue is full or empty.
+
+try_push and try_pop fail at once when the queue is full or empty; push
+and pop spin and then yield until they succeed.  The batch forms claim
+up to n consecutive cells with a single compare-and-swap.
+
+The capacity is rounded up to a power of two.  A value's copy
+constructor must not throw: the cell it was to go into has already been
+claimed.  If copying a value out throws, the values claimed by that
+call are lost, but the queue remains usable.  size() is only a snapshot
+while other threads are using the queue.
+
+*/
+
+__STL_BEGIN_NAMESPACE
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma set woff 1174
+#endif
+
+template <class T, class Alloc = alloc>
+class bounded_queue {
+public:
+  typedef T value_type;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+protected:
+  struct cell {
+    volatile size_type sequence;
+    T value;
+  };
+  typedef simple_alloc<cell, Alloc> cell_allocator;
+
+  cell* buffer;
+  size_type mask;
+  char pad0[__STL_CACHE_LINE_SIZE];
+  volatile size_type enqueue_pos;
+  char pad1[__STL_CACHE_LINE_SIZE];
+  volatile size_type dequeue_pos;
+  char pad2[__STL_CACHE_LINE_SIZE];
+
+  size_type claim(volatile size_type* counter, size_type n, size_type lag,
+                  size_type& pos);
+  void publish(size_type pos, const T& x) {
+    cell* c = buffer + (pos & mask);
+    construct(&c->value, x);
+    __stl_atomic_store(&c->sequence, pos + 1);
+  }
+  void release(size_type pos) {
+    cell* c = buffer + (pos & mask);
+    destroy(&c->value);
+    __stl_atomic_store(&c->sequence, pos + mask + 1);
+  }
+  void release(size_type pos, size_type n) {
+    for ( ; n != 0; --n, ++pos)
+      release(pos);
+  }
+
+private:
+  bounded_queue(const bounded_queue<T, Alloc>&);
+  bounded_queue<T, Alloc>& operator=(const bounded_queue<T, Alloc>&);
+
+public:
+  explicit bounded_queue(size_type n);
+  ~bounded_queue();
+
+  size_type capacity() const { return mask + 1; }
+  size_type size() const {
+    const size_type head = __stl_atomic_load(&dequeue_pos);
+    const size_type tail = __stl_atomic_load(&enqueue_pos);
+    return difference_type(tail - head) <= 0 ? 0
+                                             : min(tail - head, capacity());
+  }
+  bool empty() const { return size() == 0; }
+
+  bool try_push(const T& x) {
+    size_type pos;
+    if (claim(&enqueue_pos, 1, 0, pos) == 0)
+      return false;
+    publish(pos, x);
+    return true;
+  }
+  bool try_pop(T& x) {
+    size_type pos;
+    if (claim(&dequeue_pos, 1, 1, pos) == 0)
+      return false;
+    __STL_TRY {
+      x = buffer[pos & mask].value;
+    }
+    __STL_UNWIND(release(pos));
+    release(pos);
+    return true;
+  }
+  void push(const T& x) {
+    __stl_backoff wait;
+    while (!try_push(x))
+      wait();
+  }
+  void pop(T& x) {
+    __stl_backoff wait;
+    while (!try_pop(x))
+      wait();
+  }
+
+#ifdef __STL_MEMBER_TEMPLATES
+  // Push up to n values, taken from first on; return how many were pushed.
+  template <class InputIterator>
+  size_type try_push(InputIterator first, size_type n) {
+    return push_some(first, n);
+  }
+  // Pop up to n values into result; return how many were popped.
+  template <class OutputIterator>
+  size_type try_pop(OutputIterator result, size_type n) {
+    return pop_some(result, n);
+  }
+  template <class InputIterator>
+  void push(InputIterator first, size_type n) {
+    __stl_backoff wait;
+    while (n != 0) {
+      size_type k = push_some(first, n);
+      if (k == 0)
+        wait();
+      else
+        wait.reset();
+      n -= k;
+    }
+  }
+  template <class OutputIterator>
+  void pop(OutputIterator result, size_type n) {
+    __stl_backoff wait;
+    while (n != 0) {
+      size_type k = pop_some(result, n);
+      if (k == 0)
+        wait();
+      else
+        wait.reset();
+      n -= k;
+    }
+  }
+#else /* __STL_MEMBER_TEMPLATES */
+  size_type try_push(const T* first, size_type n) {
+    return push_some(first, n);
+  }
+  size_type try_pop(T* result, size_type n) {
+    return pop_some(result, n);
+  }
+  void push(const T* first, size_type n) {
+    __stl_backoff wait;
+    while (n != 0) {
+      size_type k = push_some(first, n);
+      if (k == 0)
+        wait();
+      else
+        wait.reset();
+      n -= k;
+    }
+  }
+  void pop(T* result, size_type n) {
+    __stl_backoff wait;
+    while (n != 0) {
+      size_type k = pop_some(result, n);
+      if (k == 0)
+        wait();
+      else
+        wait.reset();
+      n -= k;
+    }
+  }
+#endif /* __STL_MEMBER_TEMPLATES */
+
+protected:
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class InputIterator>
+  size_type push_some(InputIterator& first, size_type n) {
+    size_type pos;
+    const size_type k = claim(&enqueue_pos, min(n, capacity()), 0, pos);
+    for (size_type i = 0; i < k; ++i, ++first)
+      publish(pos + i, *first);
+    return k;
+  }
+  template <class OutputIterator>
+  size_type pop_some(OutputIterator& result, size_type n) {
+    size_type pos;
+    const size_type k = claim(&dequeue_pos, min(n, capacity()), 1, pos);
+    for (size_type i = 0; i < k; ++i) {
+      __STL_TRY {
+        *result = buffer[(pos + i) & mask].value;
+        ++result;
+      }
+      __STL_UNWIND(release(pos + i, k - i));
+      release(pos + i);
+    }
+    return k;
+  }
+#else /* __STL_MEMBER_TEMPLATES */
+  size_type push_some(const T*& first, size_type n) {
+    size_type pos;
+    const size_type k = claim(&enqueue_pos, min(n, capacity()), 0, pos);
+    for (size_type i = 0; i < k; ++i, ++first)
+      publish(pos + i, *first);
+    return k;
+  }
+  size_type pop_some(T*& result, size_type n) {
+    size_type pos;
+    const size_type k = claim(&dequeue_pos, min(n, capacity()), 1, pos);
+    for (size_type i = 0; i < k; ++i) {
+      __STL_TRY {
+        *result = buffer[(pos + i) & mask].value;
+        ++result;
+      }
+      __STL_UNWIND(release(pos + i, k - i));
+      release(pos + i);
+    }
+    return k;
+  }
+#endif /* __STL_MEMBER_TEMPLATES */
+};
+
+template <class T, class Alloc>
+bounded_queue<T, Alloc>::bounded_queue(size_type n)
+  : enqueue_pos(0), dequeue_pos(0)
+{
+  size_type cap = 2;
+  while (cap < n)
+    cap *= 2;
+  buffer = cell_allocator::allocate(cap);
+  mask = cap - 1;
+  for (size_type i = 0; i < cap; ++i)
+    buffer[i].sequence = i;
+}
+
+template <class T, class Alloc>
+bounded_queue<T, Alloc>::~bounded_queue()
+{
+  for (size_type pos = dequeue_pos; pos != enqueue_pos; ++pos)
+    destroy(&buffer[pos & mask].value);
+  cell_allocator::deallocate(buffer, capacity());
+}
+
+// Claims up to n consecutive cells starting at *counter: cells whose
+// sequence is their position plus lag, which is 0 for producers and 1
+// for consumers.  Returns how many were claimed, the first at pos.
+template <class T, class Alloc>
+typename bounded_queue<T, Alloc>::size_type
+bounded_queue<T, Alloc>::claim(volatile size_type* counter, size_type n,
+                               size_type lag, size_type& pos)
+{
+  pos = __stl_atomic_load(counter);
+  for (;;) {
+    size_type k = 0;
+    bool stale = false;
+    for ( ; k < n; ++k) {
+      const size_type seq =
+        __stl_atomic_load(&buffer[(pos + k) & mask].sequence);
+      const difference_type dif = difference_type(seq - (pos + k + lag));
+      if (dif < 0)              // the other side has not got there yet
+        break;
+      if (dif > 0) {            // another thread has taken pos
+        stale = true;
+        break;
+      }
+    }
+    if (!stale) {
+      if (k == 0)
+        return 0;
+      if (__stl_atomic_compare_and_swap(counter, pos, pos + k))
+        return k;
+    }
+    pos = __stl_atomic_load(counter);
+  }
+}
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma reset woff 1174
+#endif
+
+__STL_END_NAMESPACE
+
+#endif /* __SGI_STL_INTERNAL_BOUNDED_QUEUE_H */
+
+// Local Variables:
+// mode:C++
+// End:
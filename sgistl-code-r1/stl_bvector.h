@@ -33,16 +33,27 @@
 
 __STL_BEGIN_NAMESPACE 
 
-static const int __WORD_BIT = int(CHAR_BIT*sizeof(unsigned int));
+// Bits are stored in words of type __bit_word.  Defining
+// __STL_BVECTOR_LONG_WORDS stores them in unsigned long instead of
+// unsigned int, which on LP64 systems halves the number of words every
+// word-at-a-time operation below has to visit.  Both settings must not
+// be mixed in one program.
+#ifdef __STL_BVECTOR_LONG_WORDS
+typedef unsigned long __bit_word;
+#else
+typedef unsigned int __bit_word;
+#endif
+
+static const int __WORD_BIT = int(CHAR_BIT*sizeof(__bit_word));
 
 #if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
 #pragma set woff 1174
 #endif
 
 struct __bit_reference {
-  unsigned int* p;
-  unsigned int mask;
-  __bit_reference(unsigned int* x, unsigned int y) : p(x), mask(y) {}
+  __bit_word* p;
+  __bit_word mask;
+  __bit_reference(__bit_word* x, __bit_word y) : p(x), mask(y) {}
 
 public:
   __bit_reference() : p(0), mask(0) {}
@@ -75,7 +86,7 @@ struct __bit_iterator : public random_access_iterator<bool, ptrdiff_t> {
   typedef __bit_reference* pointer;
   typedef __bit_iterator iterator;
 
-  unsigned int* p;
+  __bit_word* p;
   unsigned int offset;
   void bump_up() {
     if (offset++ == __WORD_BIT - 1) {
@@ -91,8 +102,8 @@ struct __bit_iterator : public random_access_iterator<bool, ptrdiff_t> {
   }
 
   __bit_iterator() : p(0), offset(0) {}
-  __bit_iterator(unsigned int* x, unsigned int y) : p(x), offset(y) {}
-  reference operator*() const { return reference(p, 1U << offset); }
+  __bit_iterator(__bit_word* x, unsigned int y) : p(x), offset(y) {}
+  reference operator*() const { return reference(p, __bit_word(1) << offset); }
   iterator& operator++() {
     bump_up();
     return *this;
@@ -157,7 +168,7 @@ struct __bit_const_iterator
   typedef const bool*          pointer;
   typedef __bit_const_iterator const_iterator;
 
-  unsigned int* p;
+  __bit_word* p;
   unsigned int offset;
   void bump_up() {
     if (offset++ == __WORD_BIT - 1) {
@@ -173,10 +184,10 @@ struct __bit_const_iterator
   }
 
   __bit_const_iterator() : p(0), offset(0) {}
-  __bit_const_iterator(unsigned int* x, unsigned int y) : p(x), offset(y) {}
+  __bit_const_iterator(__bit_word* x, unsigned int y) : p(x), offset(y) {}
   __bit_const_iterator(const __bit_iterator& x) : p(x.p), offset(x.offset) {}
   const_reference operator*() const {
-    return __bit_reference(p, 1U << offset);
+    return __bit_reference(p, __bit_word(1) << offset);
   }
   const_iterator& operator++() {
     bump_up();
@@ -236,6 +247,296 @@ struct __bit_const_iterator
   }
 };
 
+// Word-at-a-time versions of the algorithms most often applied to bit
+// vectors.  Each step handles up to __WORD_BIT bits rather than one.
+// They are ordinary overloads, so a call such as count(v.begin(),
+// v.end(), true, n) picks them up whenever the arguments are bit
+// iterators and the value is a bool.
+
+#if defined(__GNUC__) && __GNUC__ * 100 + __GNUC_MINOR__ >= 304
+#  define __STL_BIT_BUILTINS
+#endif
+
+inline __bit_word __bit_mask(unsigned int k) {     // the low k bits
+  return k >= (unsigned int) __WORD_BIT ? ~__bit_word(0)
+                                        : (__bit_word(1) << k) - 1;
+}
+
+inline unsigned int __bit_popcount(__bit_word x) {
+#ifdef __STL_BIT_BUILTINS
+  return __builtin_popcountl(x);
+#else
+  unsigned int n = 0;
+  for ( ; x != 0; x &= x - 1)
+    ++n;
+  return n;
+#endif
+}
+
+// Position of the lowest set bit of x, which must not be 0.
+inline unsigned int __bit_lowest(__bit_word x) {
+#ifdef __STL_BIT_BUILTINS
+  return __builtin_ctzl(x);
+#else
+  unsigned int n = 0;
+  for ( ; !(x & 1); x >>= 1)
+    ++n;
+  return n;
+#endif
+}
+
+// Like copy, the destination may overlap the source if it starts before
+// it: each step reads its source bits before it writes.
+inline __bit_iterator __bit_copy(__bit_const_iterator first,
+                                 __bit_const_iterator last,
+                                 __bit_iterator result) {
+  ptrdiff_t n = last - first;
+  __bit_word* sp = first.p;
+  unsigned int so = first.offset;
+  __bit_word* dp = result.p;
+  unsigned int d_off = result.offset;
+  while (n > 0) {
+    unsigned int k = __WORD_BIT - (so > d_off ? so : d_off);
+    if (ptrdiff_t(k) > n)
+      k = (unsigned int) n;
+    const __bit_word m = __bit_mask(k);
+    const __bit_word bits = (*sp >> so) & m;
+    *dp = (*dp & ~(m << d_off)) | (bits << d_off);
+    n -= k;
+    if ((so += k) == (unsigned int) __WORD_BIT) {
+      so = 0;
+      ++sp;
+    }
+    if ((d_off += k) == (unsigned int) __WORD_BIT) {
+      d_off = 0;
+      ++dp;
+    }
+  }
+  return __bit_iterator(dp, d_off);
+}
+
+// The mirror image of __bit_copy, for a destination that ends after the
+// end of the source.
+inline __bit_iterator __bit_copy_backward(__bit_const_iterator first,
+                                          __bit_const_iterator last,
+                                          __bit_iterator result) {
+  ptrdiff_t n = last - first;
+  __bit_word* sp = last.p;
+  unsigned int so = last.offset;
+  __bit_word* dp = result.p;
+  unsigned int d_off = result.offset;
+  while (n > 0) {
+    if (so == 0) {
+      --sp;
+      so = __WORD_BIT;
+    }
+    if (d_off == 0) {
+      --dp;
+      d_off = __WORD_BIT;
+    }
+    unsigned int k = so < d_off ? so : d_off;
+    if (ptrdiff_t(k) > n)
+      k = (unsigned int) n;
+    const __bit_word m = __bit_mask(k);
+    so -= k;
+    d_off -= k;
+    const __bit_word bits = (*sp >> so) & m;
+    *dp = (*dp & ~(m << d_off)) | (bits << d_off);
+    n -= k;
+  }
+  return __bit_iterator(dp, d_off);
+}
+
+inline void __bit_fill(__bit_iterator first, __bit_iterator last, bool x) {
+  const __bit_word w = x ? ~__bit_word(0) : __bit_word(0);
+  if (first.p == last.p) {
+    if (first.offset != last.offset) {
+      const __bit_word m =
+        __bit_mask(last.offset - first.offset) << first.offset;
+      *first.p = (*first.p & ~m) | (w & m);
+    }
+    return;
+  }
+  __bit_word* p = first.p;
+  if (first.offset != 0) {
+    const __bit_word m = ~__bit_word(0) << first.offset;
+    *p = (*p & ~m) | (w & m);
+    ++p;
+  }
+  for ( ; p != last.p; ++p)
+    *p = w;
+  if (last.offset != 0) {
+    const __bit_word m = __bit_mask(last.offset);
+    *p = (*p & ~m) | (w & m);
+  }
+}
+
+inline ptrdiff_t __bit_count(__bit_const_iterator first,
+                             __bit_const_iterator last) {
+  if (first.p == last.p)
+    return first.offset == last.offset ? 0 :
+      __bit_popcount((*first.p >> first.offset)
+                     & __bit_mask(last.offset - first.offset));
+  ptrdiff_t n = 0;
+  __bit_word* p = first.p;
+  if (first.offset != 0) {
+    n += __bit_popcount(*p >> first.offset);
+    ++p;
+  }
+  for ( ; p != last.p; ++p)
+    n += __bit_popcount(*p);
+  if (last.offset != 0)
+    n += __bit_popcount(*p & __bit_mask(last.offset));
+  return n;
+}
+
+inline __bit_const_iterator __bit_find(__bit_const_iterator first,
+                                       __bit_const_iterator last, bool x) {
+  // Look for set bits in w ^ flip.
+  const __bit_word flip = x ? __bit_word(0) : ~__bit_word(0);
+  if (first.p == last.p) {
+    if (first.offset != last.offset) {
+      const __bit_word w = ((*first.p ^ flip) >> first.offset)
+                             & __bit_mask(last.offset - first.offset);
+      if (w != 0)
+        return __bit_const_iterator(first.p, first.offset + __bit_lowest(w));
+    }
+    return last;
+  }
+  __bit_word* p = first.p;
+  if (first.offset != 0) {
+    const __bit_word w = (*p ^ flip) >> first.offset;
+    if (w != 0)
+      return __bit_const_iterator(p, first.offset + __bit_lowest(w));
+    ++p;
+  }
+  for ( ; p != last.p; ++p)
+    if ((*p ^ flip) != 0)
+      return __bit_const_iterator(p, __bit_lowest(*p ^ flip));
+  if (last.offset != 0) {
+    const __bit_word w = (*p ^ flip) & __bit_mask(last.offset);
+    if (w != 0)
+      return __bit_const_iterator(p, __bit_lowest(w));
+  }
+  return last;
+}
+
+inline bool __bit_equal(__bit_const_iterator first1,
+                        __bit_const_iterator last1,
+                        __bit_const_iterator first2) {
+  ptrdiff_t n = last1 - first1;
+  __bit_word* p1 = first1.p;
+  unsigned int o1 = first1.offset;
+  __bit_word* p2 = first2.p;
+  unsigned int o2 = first2.offset;
+  while (n > 0) {
+    unsigned int k = __WORD_BIT - (o1 > o2 ? o1 : o2);
+    if (ptrdiff_t(k) > n)
+      k = (unsigned int) n;
+    if (((*p1 >> o1) ^ (*p2 >> o2)) & __bit_mask(k))
+      return false;
+    n -= k;
+    if ((o1 += k) == (unsigned int) __WORD_BIT) {
+      o1 = 0;
+      ++p1;
+    }
+    if ((o2 += k) == (unsigned int) __WORD_BIT) {
+      o2 = 0;
+      ++p2;
+    }
+  }
+  return true;
+}
+
+inline __bit_iterator copy(__bit_const_iterator first,
+                           __bit_const_iterator last,
+                           __bit_iterator result) {
+  return __bit_copy(first, last, result);
+}
+
+inline __bit_iterator copy(__bit_iterator first, __bit_iterator last,
+                           __bit_iterator result) {
+  return __bit_copy(first, last, result);
+}
+
+inline __bit_iterator copy_backward(__bit_const_iterator first,
+                                    __bit_const_iterator last,
+                                    __bit_iterator result) {
+  return __bit_copy_backward(first, last, result);
+}
+
+inline __bit_iterator copy_backward(__bit_iterator first,
+                                    __bit_iterator last,
+                                    __bit_iterator result) {
+  return __bit_copy_backward(first, last, result);
+}
+
+inline void fill(__bit_iterator first, __bit_iterator last, const bool& x) {
+  __bit_fill(first, last, x);
+}
+
+template <class Size>
+inline __bit_iterator fill_n(__bit_iterator first, Size n, const bool& x) {
+  __bit_iterator last = first + ptrdiff_t(n);
+  __bit_fill(first, last, x);
+  return last;
+}
+
+inline bool equal(__bit_const_iterator first1, __bit_const_iterator last1,
+                  __bit_const_iterator first2) {
+  return __bit_equal(first1, last1, first2);
+}
+
+inline bool equal(__bit_iterator first1, __bit_iterator last1,
+                  __bit_iterator first2) {
+  return __bit_equal(first1, last1, first2);
+}
+
+inline bool equal(__bit_const_iterator first1, __bit_const_iterator last1,
+                  __bit_iterator first2) {
+  return __bit_equal(first1, last1, first2);
+}
+
+inline bool equal(__bit_iterator first1, __bit_iterator last1,
+                  __bit_const_iterator first2) {
+  return __bit_equal(first1, last1, first2);
+}
+
+inline __bit_const_iterator find(__bit_const_iterator first,
+                                 __bit_const_iterator last, const bool& x) {
+  return __bit_find(first, last, x);
+}
+
+inline __bit_iterator find(__bit_iterator first, __bit_iterator last,
+                           const bool& x) {
+  __bit_const_iterator i = __bit_find(first, last, x);
+  return __bit_iterator(i.p, i.offset);
+}
+
+template <class Size>
+inline void count(__bit_const_iterator first, __bit_const_iterator last,
+                  const bool& x, Size& n) {
+  const ptrdiff_t ones = __bit_count(first, last);
+  n += Size(x ? ones : (last - first) - ones);
+}
+
+template <class Size>
+inline void count(__bit_iterator first, __bit_iterator last,
+                  const bool& x, Size& n) {
+  count(__bit_const_iterator(first), __bit_const_iterator(last), x, n);
+}
+
+inline ptrdiff_t count(__bit_const_iterator first, __bit_const_iterator last,
+                       const bool& x) {
+  const ptrdiff_t ones = __bit_count(first, last);
+  return x ? ones : (last - first) - ones;
+}
+
+inline ptrdiff_t count(__bit_iterator first, __bit_iterator last,
+                       const bool& x) {
+  return count(__bit_const_iterator(first), __bit_const_iterator(last), x);
+}
+
 // The next few lines are confusing.  What we're doing is declaring a
 //  partial specialization of vector<T, Alloc> if we have the necessary
 //  compiler support.  Otherwise, we define a class bit_vector which uses
@@ -260,9 +561,9 @@ class bit_vector
 #      endif /* __SGI_STL_VECBOOL_TEMPLATE */
 {
 #      ifdef __SGI_STL_VECBOOL_TEMPLATE
-  typedef simple_alloc<unsigned int, Alloc> data_allocator;
+  typedef simple_alloc<__bit_word, Alloc> data_allocator;
 #      else /* __SGI_STL_VECBOOL_TEMPLATE */
-  typedef simple_alloc<unsigned int, alloc> data_allocator;  
+  typedef simple_alloc<__bit_word, alloc> data_allocator;  
 #      endif /* __SGI_STL_VECBOOL_TEMPLATE */
 public:
   typedef bool value_type;
@@ -289,8 +590,11 @@ public:
 protected:
   iterator start;
   iterator finish;
-  unsigned int* end_of_storage;
-  unsigned int* bit_alloc(size_type n) {
+  __bit_word* end_of_storage;
+  __bit_word* word_end() const {     // past the last word in use
+    return finish.p + (finish.offset != 0 ? 1 : 0);
+  }
+  __bit_word* bit_alloc(size_type n) {
     return data_allocator::allocate((n + __WORD_BIT - 1)/__WORD_BIT);
   }
   void deallocate() {
@@ -298,7 +602,7 @@ protected:
       data_allocator::deallocate(start.p, end_of_storage - start.p);
   }
   void initialize(size_type n) {
-    unsigned int* q = bit_alloc(n);
+    __bit_word* q = bit_alloc(n);
     end_of_storage = q + (n + __WORD_BIT - 1)/__WORD_BIT;
     start = iterator(q, 0);
     finish = start + difference_type(n);
@@ -311,7 +615,7 @@ protected:
     }
     else {
       size_type len = size() ? 2 * size() : __WORD_BIT;
-      unsigned int* q = bit_alloc(len);
+      __bit_word* q = bit_alloc(len);
       iterator i = copy(begin(), position, iterator(q, 0));
       *i++ = x;
       finish = copy(position, end(), i);
@@ -365,7 +669,7 @@ protected:
       }
       else {
         size_type len = size() + max(size(), n);
-        unsigned int* q = bit_alloc(len);
+        __bit_word* q = bit_alloc(len);
         iterator i = copy(begin(), position, iterator(q, 0));
         i = copy(first, last, i);
         finish = copy(position, end(), i);
@@ -460,7 +764,7 @@ public:
   }
   void reserve(size_type n) {
     if (capacity() < n) {
-      unsigned int* q = bit_alloc(n);
+      __bit_word* q = bit_alloc(n);
       finish = copy(begin(), end(), iterator(q, 0));
       deallocate();
       start = iterator(q, 0);
@@ -510,7 +814,7 @@ public:
     }
     else {
       size_type len = size() + max(size(), n);
-      unsigned int* q = bit_alloc(len);
+      __bit_word* q = bit_alloc(len);
       iterator i = copy(begin(), position, iterator(q, 0));
       i = copy(first, last, i);
       finish = copy(position, end(), i);
@@ -531,7 +835,7 @@ public:
     }
     else {
       size_type len = size() + max(size(), n);
-      unsigned int* q = bit_alloc(len);
+      __bit_word* q = bit_alloc(len);
       iterator i = copy(begin(), position, iterator(q, 0));
       i = copy(first, last, i);
       finish = copy(position, end(), i);
@@ -551,7 +855,7 @@ public:
     }
     else {
       size_type len = size() + max(size(), n);
-      unsigned int* q = bit_alloc(len);
+      __bit_word* q = bit_alloc(len);
       iterator i = copy(begin(), position, iterator(q, 0));
       fill_n(i, n, x);
       finish = copy(position, end(), i + difference_type(n));
@@ -582,6 +886,62 @@ public:
       insert(end(), new_size - size(), x);
   }
   void clear() { erase(begin(), end()); }
+
+                                // whole-vector bit operations; the two
+                                // operands must have the same size.
+  void flip() {
+    for (__bit_word* p = start.p; p != word_end(); ++p)
+      *p = ~*p;
+  }
+  __BVECTOR& operator&=(const __BVECTOR& x) {
+    __stl_assert(size() == x.size());
+    const __bit_word* q = x.start.p;
+    for (__bit_word* p = start.p; p != word_end(); ++p, ++q)
+      *p &= *q;
+    return *this;
+  }
+  __BVECTOR& operator|=(const __BVECTOR& x) {
+    __stl_assert(size() == x.size());
+    const __bit_word* q = x.start.p;
+    for (__bit_word* p = start.p; p != word_end(); ++p, ++q)
+      *p |= *q;
+    return *this;
+  }
+  __BVECTOR& operator^=(const __BVECTOR& x) {
+    __stl_assert(size() == x.size());
+    const __bit_word* q = x.start.p;
+    for (__bit_word* p = start.p; p != word_end(); ++p, ++q)
+      *p ^= *q;
+    return *this;
+  }
+  __BVECTOR operator&(const __BVECTOR& x) const {
+    __BVECTOR tmp(*this);
+    return tmp &= x;
+  }
+  __BVECTOR operator|(const __BVECTOR& x) const {
+    __BVECTOR tmp(*this);
+    return tmp |= x;
+  }
+  __BVECTOR operator^(const __BVECTOR& x) const {
+    __BVECTOR tmp(*this);
+    return tmp ^= x;
+  }
+  __BVECTOR operator~() const {
+    __BVECTOR tmp(*this);
+    tmp.flip();
+    return tmp;
+  }
+
+                                // index of the first set bit, or of the
+                                // first set bit after prev; size() if
+                                // there is none.
+  size_type find_first() const {
+    return size_type(find(begin(), end(), true) - begin());
+  }
+  size_type find_next(size_type prev) const {
+    return size_type(find(begin() + difference_type(prev + 1), end(), true)
+                     - begin());
+  }
 };
 
 #ifdef __SGI_STL_VECBOOL_TEMPLATE
@@ -602,6 +962,7 @@ inline bool operator<(const bit_vector& x, const bit_vector& y) {
 
 #undef __SGI_STL_VECBOOL_TEMPLATE
 #undef __BVECTOR
+#undef __STL_BIT_BUILTINS
 
 #if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
 #pragma reset woff 1174
@@ -70,6 +70,10 @@
 //       appropriately.
 //  (19) Defines __stl_assert either as a test or as a null macro,
 //       depending on whether or not __STL_ASSERTIONS is defined.
+//  (20) Defines __STL_PREFETCH(addr) as a read prefetch hint if the
+//       compiler has one, and as a null macro otherwise.
+//  (21) Defines __STL_CACHE_LINE_SIZE, the assumed size in bytes of a
+//       cache line, unless the user has already defined it.
 
 #ifdef _PTHREADS
 #   define __STL_PTHREADS
@@ -243,6 +247,17 @@
 # define __stl_assert(expr)
 #endif
 
+#if defined(__GNUC__) && \
+    (__GNUC__ > 3 || (__GNUC__ == 3 && __GNUC_MINOR__ >= 1))
+# define __STL_PREFETCH(addr) __builtin_prefetch((const void*)(addr))
+#else
+# define __STL_PREFETCH(addr)
+#endif
+
+#ifndef __STL_CACHE_LINE_SIZE
+# define __STL_CACHE_LINE_SIZE 64
+#endif
+
 #endif /* __STL_CONFIG_H */
 
 // Local Variables:
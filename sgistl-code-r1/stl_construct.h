@@ -13,6 +13,16 @@ inline void construct(T1* p, const T2& value) {
   new (p) T1(value);	//placement new
 }
 
+template <class T1>
+inline void construct(T1* p) {
+  new (p) T1();
+}
+
+// Tag asking a container to default-initialize new elements: those with
+// a trivial default constructor are left uninitialized instead of being
+// set to T().  Meant for buffers that are about to be overwritten.
+struct default_init_t {};
+
 
 template <class T>
 inline void destroy(T* pointer) 
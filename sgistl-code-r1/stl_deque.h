@@ -77,6 +77,20 @@
  * that is the case.  If your compiler is one of them, then you will
  * not be able to use alternate node sizes; you will have to use the
  * default value.
+ *
+ * The default node size is the number of elements that fit in
+ * __STL_DEQUE_BUF_BYTES bytes (512 unless defined otherwise before this
+ * header is included), or one element if they are larger than that.
+ *
+ * A deque keeps up to spare_node_max nodes that it no longer needs
+ * rather than freeing them at once, and uses them before allocating new
+ * ones.  A deque used as a FIFO queue thus reaches a steady state in
+ * which pop_front hands its emptied node to push_back and neither of
+ * them calls the allocator.  Spare nodes are freed with the deque.
+ *
+ * The map only grows as nodes are added.  shrink_to_fit() frees the
+ * spare nodes and, if the map is much larger than the deque now needs,
+ * replaces it with a smaller one.
  */
 
 __STL_BEGIN_NAMESPACE 
@@ -85,13 +99,29 @@ __STL_BEGIN_NAMESPACE
 #pragma set woff 1174
 #endif
 
+#ifndef __STL_DEQUE_BUF_BYTES
+#  define __STL_DEQUE_BUF_BYTES 512
+#endif
+
 // Note: this function is simply a kludge to work around several compilers'
 //  bugs in handling constant expressions.
 inline size_t __deque_buf_size(size_t n, size_t sz)
 {
-  return n != 0 ? n : (sz < 512 ? size_t(512 / sz) : size_t(1));
+  return n != 0 ? n : (sz < __STL_DEQUE_BUF_BYTES
+                       ? size_t(__STL_DEQUE_BUF_BYTES / sz) : size_t(1));
 }
 
+#ifdef __STL_DEQUE_STATS
+// With __STL_DEQUE_STATS defined, each deque type counts the times it
+// has had to make room in its map, in deque<...>::stats(): by moving
+// the node pointers back to the middle of the map, or by allocating a
+// larger map.  The counters are not synchronized.
+struct deque_stats {
+  size_t map_recenterings;
+  size_t map_reallocations;
+};
+#endif /* __STL_DEQUE_STATS */
+
 #ifndef __STL_NON_TYPE_TMPL_PARAM_BUG
 template <class T, class Ref, class Ptr, size_t BufSiz>
 struct __deque_iterator {
@@ -246,6 +276,215 @@ inline ptrdiff_t* distance_type(const __deque_iterator<T, Ref, Ptr>&) {
 
 #endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
 
+// Segmented versions of the algorithms most often applied to deques.
+// A pair of deque iterators is split into the contiguous pieces of the
+// nodes it spans, and each piece is handled as a range of pointers: the
+// per-element node-boundary test of the iterator disappears, and copy
+// and fill reach their memmove and memset forms for suitable types.
+// When only the destination is a deque iterator, the source is split
+// at the destination's node boundaries instead.  Overlapping ranges
+// behave as they do for the ordinary copy and copy_backward.
+
+#if defined(__STL_FUNCTION_TMPL_PARTIAL_ORDER) && \
+    !defined(__STL_NON_TYPE_TMPL_PARAM_BUG)
+
+template <class U, class T, size_t BufSiz>
+__deque_iterator<T, T&, T*, BufSiz>
+copy(U* first, U* last, __deque_iterator<T, T&, T*, BufSiz> result) {
+  ptrdiff_t n = last - first;
+  while (n > 0) {
+    const ptrdiff_t k = min(n, ptrdiff_t(result.last - result.cur));
+    copy(first, first + k, result.cur);
+    first += k;
+    n -= k;
+    result += k;
+  }
+  return result;
+}
+
+template <class U, class T, size_t BufSiz>
+__deque_iterator<T, T&, T*, BufSiz>
+copy_backward(U* first, U* last, __deque_iterator<T, T&, T*, BufSiz> result) {
+  ptrdiff_t n = last - first;
+  while (n > 0) {
+    ptrdiff_t room = result.cur - result.first;
+    T* end = result.cur;
+    if (room == 0) {            // result is at the start of its node
+      room = __deque_iterator<T, T&, T*, BufSiz>::buffer_size();
+      end = *(result.node - 1) + room;
+    }
+    const ptrdiff_t k = min(n, room);
+    copy_backward(last - k, last, end);
+    last -= k;
+    n -= k;
+    result -= k;
+  }
+  return result;
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz, class OutputIterator>
+OutputIterator __deque_copy(__deque_iterator<T, Ref, Ptr, BufSiz> first,
+                            __deque_iterator<T, Ref, Ptr, BufSiz> last,
+                            OutputIterator result) {
+  if (first.node == last.node)
+    return copy(first.cur, last.cur, result);
+  result = copy(first.cur, first.last, result);
+  for (T** node = first.node + 1; node != last.node; ++node)
+    result = copy(*node, *node + first.buffer_size(), result);
+  return copy(last.first, last.cur, result);
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz,
+          class BidirectionalIterator>
+BidirectionalIterator
+__deque_copy_backward(__deque_iterator<T, Ref, Ptr, BufSiz> first,
+                      __deque_iterator<T, Ref, Ptr, BufSiz> last,
+                      BidirectionalIterator result) {
+  if (first.node == last.node)
+    return copy_backward(first.cur, last.cur, result);
+  result = copy_backward(last.first, last.cur, result);
+  for (T** node = last.node - 1; node != first.node; --node)
+    result = copy_backward(*node, *node + first.buffer_size(), result);
+  return copy_backward(first.cur, first.last, result);
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz, class OutputIterator>
+inline OutputIterator copy(__deque_iterator<T, Ref, Ptr, BufSiz> first,
+                           __deque_iterator<T, Ref, Ptr, BufSiz> last,
+                           OutputIterator result) {
+  return __deque_copy(first, last, result);
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz, class T2,
+          size_t BufSiz2>
+inline __deque_iterator<T2, T2&, T2*, BufSiz2>
+copy(__deque_iterator<T, Ref, Ptr, BufSiz> first,
+     __deque_iterator<T, Ref, Ptr, BufSiz> last,
+     __deque_iterator<T2, T2&, T2*, BufSiz2> result) {
+  return __deque_copy(first, last, result);
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz,
+          class BidirectionalIterator>
+inline BidirectionalIterator
+copy_backward(__deque_iterator<T, Ref, Ptr, BufSiz> first,
+              __deque_iterator<T, Ref, Ptr, BufSiz> last,
+              BidirectionalIterator result) {
+  return __deque_copy_backward(first, last, result);
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz, class T2,
+          size_t BufSiz2>
+inline __deque_iterator<T2, T2&, T2*, BufSiz2>
+copy_backward(__deque_iterator<T, Ref, Ptr, BufSiz> first,
+              __deque_iterator<T, Ref, Ptr, BufSiz> last,
+              __deque_iterator<T2, T2&, T2*, BufSiz2> result) {
+  return __deque_copy_backward(first, last, result);
+}
+
+template <class T, size_t BufSiz, class T2>
+void fill(__deque_iterator<T, T&, T*, BufSiz> first,
+          __deque_iterator<T, T&, T*, BufSiz> last, const T2& value) {
+  if (first.node == last.node) {
+    fill(first.cur, last.cur, value);
+    return;
+  }
+  fill(first.cur, first.last, value);
+  for (T** node = first.node + 1; node != last.node; ++node)
+    fill(*node, *node + first.buffer_size(), value);
+  fill(last.first, last.cur, value);
+}
+
+template <class T, size_t BufSiz, class Size, class T2>
+inline __deque_iterator<T, T&, T*, BufSiz>
+fill_n(__deque_iterator<T, T&, T*, BufSiz> first, Size n, const T2& value) {
+  __deque_iterator<T, T&, T*, BufSiz> last = first + ptrdiff_t(n);
+  fill(first, last, value);
+  return last;
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz, class T2>
+__deque_iterator<T, Ref, Ptr, BufSiz>
+find(__deque_iterator<T, Ref, Ptr, BufSiz> first,
+     __deque_iterator<T, Ref, Ptr, BufSiz> last, const T2& value) {
+  for (;;) {
+    Ptr end = first.node == last.node ? last.cur : first.last;
+    for (Ptr p = first.cur; p != end; ++p)
+      if (*p == value) {
+        first.cur += p - first.cur;
+        return first;
+      }
+    if (first.node == last.node)
+      return last;
+    first.set_node(first.node + 1);
+    first.cur = first.first;
+  }
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz, class Predicate>
+__deque_iterator<T, Ref, Ptr, BufSiz>
+find_if(__deque_iterator<T, Ref, Ptr, BufSiz> first,
+        __deque_iterator<T, Ref, Ptr, BufSiz> last, Predicate pred) {
+  for (;;) {
+    Ptr end = first.node == last.node ? last.cur : first.last;
+    for (Ptr p = first.cur; p != end; ++p)
+      if (pred(*p)) {
+        first.cur += p - first.cur;
+        return first;
+      }
+    if (first.node == last.node)
+      return last;
+    first.set_node(first.node + 1);
+    first.cur = first.first;
+  }
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz, class Function>
+Function for_each(__deque_iterator<T, Ref, Ptr, BufSiz> first,
+                  __deque_iterator<T, Ref, Ptr, BufSiz> last, Function f) {
+  for (;;) {
+    Ptr end = first.node == last.node ? last.cur : first.last;
+    for (Ptr p = first.cur; p != end; ++p)
+      f(*p);
+    if (first.node == last.node)
+      return f;
+    first.set_node(first.node + 1);
+    first.cur = first.first;
+  }
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz, class U>
+U accumulate(__deque_iterator<T, Ref, Ptr, BufSiz> first,
+             __deque_iterator<T, Ref, Ptr, BufSiz> last, U init) {
+  for (;;) {
+    Ptr end = first.node == last.node ? last.cur : first.last;
+    for (Ptr p = first.cur; p != end; ++p)
+      init = init + *p;
+    if (first.node == last.node)
+      return init;
+    first.set_node(first.node + 1);
+    first.cur = first.first;
+  }
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz, class U,
+          class BinaryOperation>
+U accumulate(__deque_iterator<T, Ref, Ptr, BufSiz> first,
+             __deque_iterator<T, Ref, Ptr, BufSiz> last, U init,
+             BinaryOperation binary_op) {
+  for (;;) {
+    Ptr end = first.node == last.node ? last.cur : first.last;
+    for (Ptr p = first.cur; p != end; ++p)
+      init = binary_op(init, *p);
+    if (first.node == last.node)
+      return init;
+    first.set_node(first.node + 1);
+    first.cur = first.first;
+  }
+}
+
+#endif /* __STL_FUNCTION_TMPL_PARTIAL_ORDER */
+
 // See __deque_buf_size().  The only reason that the default value is 0
 //  is as a workaround for bugs in the way that some compilers handle
 //  constant expressions.
@@ -263,7 +502,7 @@ public:                         // Basic types
 public:                         // Iterators
 #ifndef __STL_NON_TYPE_TMPL_PARAM_BUG
   typedef __deque_iterator<T, T&, T*, BufSiz>              iterator;
-  typedef __deque_iterator<T, const T&, const T&, BufSiz>  const_iterator;
+  typedef __deque_iterator<T, const T&, const T*, BufSiz>  const_iterator;
 #else /* __STL_NON_TYPE_TMPL_PARAM_BUG */
   typedef __deque_iterator<T, T&, T*>                      iterator;
   typedef __deque_iterator<T, const T&, const T*>          const_iterator;
@@ -289,6 +528,7 @@ protected:                      // Internal typedefs
     return __deque_buf_size(BufSiz, sizeof(value_type));
   }
   static size_type initial_map_size() { return 8; }
+  enum { spare_node_max = 2 };
 
 protected:                      // Data members
   iterator start;
@@ -297,6 +537,9 @@ protected:                      // Data members
   map_pointer map;
   size_type map_size;
 
+  pointer spare_nodes[spare_node_max];
+  size_type spare_node_count;
+
 public:                         // Basic accessors
   iterator begin() { return start; }
   iterator end() { return finish; }
@@ -336,13 +579,13 @@ public:                         // Basic accessors
 
 public:                         // Constructor, destructor.
   deque()
-    : start(), finish(), map(0), map_size(0)
+    : start(), finish(), map(0), map_size(0), spare_node_count(0)
   {
     create_map_and_nodes(0);
   }
 
   deque(const deque& x)
-    : start(), finish(), map(0), map_size(0)
+    : start(), finish(), map(0), map_size(0), spare_node_count(0)
   {
     create_map_and_nodes(x.size());
     __STL_TRY {
@@ -352,25 +595,25 @@ public:                         // Constructor, destructor.
   }
 
   deque(size_type n, const value_type& value)
-    : start(), finish(), map(0), map_size(0)
+    : start(), finish(), map(0), map_size(0), spare_node_count(0)
   {
     fill_initialize(n, value);
   }
 
   deque(int n, const value_type& value)
-    : start(), finish(), map(0), map_size(0)
+    : start(), finish(), map(0), map_size(0), spare_node_count(0)
   {
     fill_initialize(n, value);
   }
  
   deque(long n, const value_type& value)
-    : start(), finish(), map(0), map_size(0)
+    : start(), finish(), map(0), map_size(0), spare_node_count(0)
   {
     fill_initialize(n, value);
   }
 
   explicit deque(size_type n)
-    : start(), finish(), map(0), map_size(0)
+    : start(), finish(), map(0), map_size(0), spare_node_count(0)
   {
     fill_initialize(n, value_type());
   }
@@ -379,7 +622,7 @@ public:                         // Constructor, destructor.
 
   template <class InputIterator>
   deque(InputIterator first, InputIterator last)
-    : start(), finish(), map(0), map_size(0)
+    : start(), finish(), map(0), map_size(0), spare_node_count(0)
   {
     range_initialize(first, last, iterator_category(first));
   }
@@ -387,7 +630,7 @@ public:                         // Constructor, destructor.
 #else /* __STL_MEMBER_TEMPLATES */
 
   deque(const value_type* first, const value_type* last)
-    : start(), finish(), map(0), map_size(0)
+    : start(), finish(), map(0), map_size(0), spare_node_count(0)
   {
     create_map_and_nodes(last - first);
     __STL_TRY {
@@ -397,7 +640,7 @@ public:                         // Constructor, destructor.
   }
 
   deque(const_iterator first, const_iterator last)
-    : start(), finish(), map(0), map_size(0)
+    : start(), finish(), map(0), map_size(0), spare_node_count(0)
   {
     create_map_and_nodes(last - first);
     __STL_TRY {
@@ -472,6 +715,27 @@ public:                         // push_* and pop_*
       pop_front_aux();
   }
 
+  // Bulk forms of push_back and pop_front, which work a node at a time.
+  // push_back_n appends the n elements starting at first, allocating
+  // all the nodes they need at once; if copying one throws, none are
+  // appended.  pop_front_n copies the first n elements, where n must not
+  // exceed size(), to result and removes them.
+
+#ifdef __STL_MEMBER_TEMPLATES
+
+  template <class InputIterator>
+  void push_back_n(InputIterator first, size_type n);
+
+  template <class OutputIterator>
+  OutputIterator pop_front_n(OutputIterator result, size_type n);
+
+#else /* __STL_MEMBER_TEMPLATES */
+
+  void push_back_n(const value_type* first, size_type n);
+  value_type* pop_front_n(value_type* result, size_type n);
+
+#endif /* __STL_MEMBER_TEMPLATES */
+
 public:                         // Insert
 
   iterator insert(iterator position, const value_type& x) {
@@ -544,6 +808,16 @@ public:                         // Erase
   iterator erase(iterator first, iterator last);
   void clear(); 
 
+  // Frees spare nodes and shrinks the map.  Invalidates iterators.
+  void shrink_to_fit();
+
+#ifdef __STL_DEQUE_STATS
+  static deque_stats& stats() {
+    static deque_stats s;
+    return s;
+  }
+#endif /* __STL_DEQUE_STATS */
+
 protected:                        // Internal construction/destruction
 
   void create_map_and_nodes(size_type num_elements);
@@ -641,9 +915,20 @@ protected:                      // Allocation of map and nodes
 
   void reallocate_map(size_type nodes_to_add, bool add_at_front);
 
-  pointer allocate_node() { return data_allocator::allocate(buffer_size()); }
+  pointer allocate_node() {
+    return spare_node_count != 0 ? spare_nodes[--spare_node_count]
+                                 : data_allocator::allocate(buffer_size());
+  }
   void deallocate_node(pointer n) {
-    data_allocator::deallocate(n, buffer_size());
+    if (spare_node_count < spare_node_max)
+      spare_nodes[spare_node_count++] = n;
+    else
+      data_allocator::deallocate(n, buffer_size());
+  }
+  void release_spare_nodes() {
+    while (spare_node_count != 0)
+      data_allocator::deallocate(spare_nodes[--spare_node_count],
+                                 buffer_size());
   }
 
 #ifdef __STL_NON_TYPE_TMPL_PARAM_BUG
@@ -749,7 +1034,7 @@ deque<T, Alloc, BufSize>::erase(iterator first, iterator last) {
       iterator new_start = start + n;
       destroy(start, new_start);
       for (map_pointer cur = start.node; cur < new_start.node; ++cur)
-        data_allocator::deallocate(*cur, buffer_size());
+        deallocate_node(*cur);
       start = new_start;
     }
     else {
@@ -757,7 +1042,7 @@ deque<T, Alloc, BufSize>::erase(iterator first, iterator last) {
       iterator new_finish = finish - n;
       destroy(new_finish, finish);
       for (map_pointer cur = new_finish.node + 1; cur <= finish.node; ++cur)
-        data_allocator::deallocate(*cur, buffer_size());
+        deallocate_node(*cur);
       finish = new_finish;
     }
     return start + elems_before;
@@ -768,13 +1053,13 @@ template <class T, class Alloc, size_t BufSize>
 void deque<T, Alloc, BufSize>::clear() {
   for (map_pointer node = start.node + 1; node < finish.node; ++node) {
     destroy(*node, *node + buffer_size());
-    data_allocator::deallocate(*node, buffer_size());
+    deallocate_node(*node);
   }
 
   if (start.node != finish.node) {
     destroy(start.cur, start.last);
     destroy(finish.first, finish.cur);
-    data_allocator::deallocate(finish.first, buffer_size());
+    deallocate_node(finish.first);
   }
   else
     destroy(start.cur, finish.cur);
@@ -801,6 +1086,7 @@ void deque<T, Alloc, BufSize>::create_map_and_nodes(size_type num_elements) {
   catch(...) {
     for (map_pointer n = nstart; n < cur; ++n)
       deallocate_node(*n);
+    release_spare_nodes();
     map_allocator::deallocate(map, map_size);
     throw;
   }
@@ -817,6 +1103,7 @@ template <class T, class Alloc, size_t BufSize>
 void deque<T, Alloc, BufSize>::destroy_map_and_nodes() {
   for (map_pointer cur = start.node; cur <= finish.node; ++cur)
     deallocate_node(*cur);
+  release_spare_nodes();
   map_allocator::deallocate(map, map_size);
 }
   
@@ -927,6 +1214,86 @@ void deque<T, Alloc, BufSize>::pop_front_aux() {
 
 #ifdef __STL_MEMBER_TEMPLATES  
 
+template <class T, class Alloc, size_t BufSize>
+template <class InputIterator>
+void deque<T, Alloc, BufSize>::push_back_n(InputIterator first, size_type n) {
+  iterator new_finish = reserve_elements_at_back(n);
+  iterator cur = finish;
+  __STL_TRY {
+    while (n != 0) {
+      const size_type k = min(n, size_type(cur.last - cur.cur));
+      first = uninitialized_copy_n(first, k, cur.cur).first;
+      cur += difference_type(k);
+      n -= k;
+    }
+    finish = new_finish;
+  }
+  __STL_UNWIND((destroy(finish, cur), destroy_nodes_at_back(new_finish)));
+}
+
+template <class T, class Alloc, size_t BufSize>
+template <class OutputIterator>
+OutputIterator
+deque<T, Alloc, BufSize>::pop_front_n(OutputIterator result, size_type n) {
+  while (n != 0) {
+    const size_type k = min(n, size_type(start.last - start.cur));
+    result = copy(start.cur, start.cur + k, result);
+    destroy(start.cur, start.cur + k);
+    n -= k;
+    if (start.cur + k == start.last) {
+      deallocate_node(start.first);
+      start.set_node(start.node + 1);
+      start.cur = start.first;
+    }
+    else
+      start.cur += k;
+  }
+  return result;
+}
+
+#else /* __STL_MEMBER_TEMPLATES */
+
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::push_back_n(const value_type* first,
+                                           size_type n) {
+  iterator new_finish = reserve_elements_at_back(n);
+  iterator cur = finish;
+  __STL_TRY {
+    while (n != 0) {
+      const size_type k = min(n, size_type(cur.last - cur.cur));
+      uninitialized_copy(first, first + k, cur.cur);
+      first += k;
+      cur += difference_type(k);
+      n -= k;
+    }
+    finish = new_finish;
+  }
+  __STL_UNWIND((destroy(finish, cur), destroy_nodes_at_back(new_finish)));
+}
+
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::value_type*
+deque<T, Alloc, BufSize>::pop_front_n(value_type* result, size_type n) {
+  while (n != 0) {
+    const size_type k = min(n, size_type(start.last - start.cur));
+    result = copy(start.cur, start.cur + k, result);
+    destroy(start.cur, start.cur + k);
+    n -= k;
+    if (start.cur + k == start.last) {
+      deallocate_node(start.first);
+      start.set_node(start.node + 1);
+      start.cur = start.first;
+    }
+    else
+      start.cur += k;
+  }
+  return result;
+}
+
+#endif /* __STL_MEMBER_TEMPLATES */
+
+#ifdef __STL_MEMBER_TEMPLATES  
+
 template <class T, class Alloc, size_t BufSize>
 template <class InputIterator>
 void deque<T, Alloc, BufSize>::insert(iterator pos,
@@ -1269,6 +1636,9 @@ void deque<T, Alloc, BufSize>::reallocate_map(size_type nodes_to_add,
 
   map_pointer new_nstart;
   if (map_size > 2 * new_num_nodes) {
+#ifdef __STL_DEQUE_STATS
+    ++stats().map_recenterings;
+#endif /* __STL_DEQUE_STATS */
     new_nstart = map + (map_size - new_num_nodes) / 2 
                      + (add_at_front ? nodes_to_add : 0);
     if (new_nstart < start.node)
@@ -1277,6 +1647,9 @@ void deque<T, Alloc, BufSize>::reallocate_map(size_type nodes_to_add,
       copy_backward(start.node, finish.node + 1, new_nstart + old_num_nodes);
   }
   else {
+#ifdef __STL_DEQUE_STATS
+    ++stats().map_reallocations;
+#endif /* __STL_DEQUE_STATS */
     size_type new_map_size = map_size + max(map_size, nodes_to_add) + 2;
 
     map_pointer new_map = map_allocator::allocate(new_map_size);
@@ -1293,6 +1666,29 @@ void deque<T, Alloc, BufSize>::reallocate_map(size_type nodes_to_add,
   finish.set_node(new_nstart + old_num_nodes - 1);
 }
 
+// The new map is the smallest in which reallocate_map, adding a node to
+// a deque of this size, will recenter the nodes rather than allocate a
+// larger map again.
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::shrink_to_fit() {
+  release_spare_nodes();
+  const size_type num_nodes = finish.node - start.node + 1;
+  const size_type new_map_size = max(initial_map_size(),
+                                     2 * (num_nodes + 1) + 1);
+  if (new_map_size >= map_size)
+    return;
+
+  map_pointer new_map = map_allocator::allocate(new_map_size);
+  map_pointer new_nstart = new_map + (new_map_size - num_nodes) / 2;
+  copy(start.node, finish.node + 1, new_nstart);
+  map_allocator::deallocate(map, map_size);
+
+  map = new_map;
+  map_size = new_map_size;
+  start.set_node(new_nstart);
+  finish.set_node(new_nstart + num_nodes - 1);
+}
+
 
 // Nonmember functions.
 
@@ -1327,6 +1723,15 @@ inline void swap(deque<T, Alloc, BufSiz>& x, deque<T, Alloc, BufSiz>& y) {
 #endif
           
 __STL_END_NAMESPACE 
+
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+
+template <class T, class Alloc, size_t BufSiz>
+struct __relocate_traits<__STD::deque<T, Alloc, BufSiz> > {
+  typedef __true_type is_trivially_relocatable;
+};
+
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
   
 #endif /* __SGI_STL_INTERNAL_DEQUE_H */
 
@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 1997
+ * Silicon Graphics Computer Systems, Inc.
+ *
+ * Permission to use, copy, modify, distribute and sell this software
+ * and its documentation for any purpose is hereby granted without fee,
+ * provided that the above copyright notice appear in all copies and
+ * that both that copyright notice and this permission notice appear
+ * in supporting documentation.  Silicon Graphics makes no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ */
+
+/* NOTE: This is an internal header file, included by other STL headers.
+ *   You should not attempt to use it directly.
+ */
+
+#ifndef __SGI_STL_INTERNAL_EYTZINGER_H
+#define __SGI_STL_INTERNAL_EYTZINGER_H
+
+/*
+
+Static search array in Eytzinger (breadth-first) order.
+
+A sorted sequence of n elements is stored as an implicit complete
+binary search tree: element k (1 <= k <= n) has children 2k and 2k+1.
+The first levels of every search share a few cache lines, and the
+elements a search may visit a few levels further down are adjacent, so
+they can be prefetched with one request while the current comparison
+proceeds.  Each step of the search is branch free.  For large arrays
+this is considerably faster than __lower_bound over the sorted range.
+
+lower_bound, upper_bound and equal_range return the same positions as
+the algorithms in stl_algo.h would on the sorted sequence.  Iterators
+are bidirectional and visit the elements in sorted order.  The array
+is immutable once built.
+
+*/
+
+__STL_BEGIN_NAMESPACE
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma set woff 1174
+#endif
+
+template <class T>
+struct __eytzinger_iterator
+{
+  typedef T value_type;
+  typedef const T& reference;
+  typedef const T* pointer;
+  typedef bidirectional_iterator_tag iterator_category;
+  typedef ptrdiff_t difference_type;
+  typedef size_t size_type;
+  typedef __eytzinger_iterator<T> self;
+
+  const T* base;                // base[1 .. n] hold the elements
+  size_type k;                  // current index; 0 is end()
+  size_type n;
+
+  __eytzinger_iterator() : base(0), k(0), n(0) {}
+  __eytzinger_iterator(const T* b, size_type i, size_type sz)
+    : base(b), k(i), n(sz) {}
+
+  reference operator*() const { return base[k]; }
+#ifndef __SGI_STL_NO_ARROW_OPERATOR
+  pointer operator->() const { return &(operator*()); }
+#endif /* __SGI_STL_NO_ARROW_OPERATOR */
+
+  void increment() {
+    if (2 * k + 1 <= n) {       // leftmost node of the right subtree
+      k = 2 * k + 1;
+      while (2 * k <= n)
+        k = 2 * k;
+    }
+    else {                      // climb while we are a right child
+      while (k & 1)
+        k >>= 1;
+      k >>= 1;
+    }
+  }
+
+  void decrement() {
+    if (k == 0) {               // end(): the rightmost node
+      k = 1;
+      while (2 * k + 1 <= n)
+        k = 2 * k + 1;
+    }
+    else if (2 * k <= n) {      // rightmost node of the left subtree
+      k = 2 * k;
+      while (2 * k + 1 <= n)
+        k = 2 * k + 1;
+    }
+    else {                      // climb while we are a left child
+      while (k != 0 && !(k & 1))
+        k >>= 1;
+      k >>= 1;
+    }
+  }
+
+  self& operator++() { increment(); return *this; }
+  self operator++(int) {
+    self tmp = *this;
+    increment();
+    return tmp;
+  }
+  self& operator--() { decrement(); return *this; }
+  self operator--(int) {
+    self tmp = *this;
+    decrement();
+    return tmp;
+  }
+
+  bool operator==(const self& x) const { return k == x.k; }
+  bool operator!=(const self& x) const { return k != x.k; }
+};
+
+#ifndef __STL_CLASS_PARTIAL_SPECIALIZATION
+
+template <class T>
+inline bidirectional_iterator_tag
+iterator_category(const __eytzinger_iterator<T>&) {
+  return bidirectional_iterator_tag();
+}
+
+template <class T>
+inline ptrdiff_t*
+distance_type(const __eytzinger_iterator<T>&) {
+  return (ptrdiff_t*) 0;
+}
+
+template <class T>
+inline T* value_type(const __eytzinger_iterator<T>&) {
+  return (T*) 0;
+}
+
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
+// The largest power of two that is at most N, or 1 if N is 0.
+template <size_t N>
+struct __eytzinger_pow2_floor {
+  enum { value = 2 * __eytzinger_pow2_floor<N / 2>::value };
+};
+__STL_TEMPLATE_NULL struct __eytzinger_pow2_floor<1> { enum { value = 1 }; };
+__STL_TEMPLATE_NULL struct __eytzinger_pow2_floor<0> { enum { value = 1 }; };
+
+#ifndef __STL_LIMITED_DEFAULT_TEMPLATES
+template <class T, class Compare = less<T>, class Alloc = alloc>
+#else
+template <class T, class Compare, class Alloc = alloc>
+#endif
+class eytzinger_array {
+public:
+  typedef T value_type;
+  typedef Compare key_compare;
+  typedef const value_type* pointer;
+  typedef const value_type* const_pointer;
+  typedef const value_type& reference;
+  typedef const value_type& const_reference;
+  typedef __eytzinger_iterator<T> const_iterator;
+  typedef const_iterator iterator;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+protected:
+  typedef simple_alloc<value_type, Alloc> data_allocator;
+
+  // Indices k * prefetch_stride .. k * prefetch_stride + prefetch_stride - 1
+  // are the descendants of k log2(prefetch_stride) levels down.  They take
+  // at most a cache line, but the allocator does not align data to one,
+  // so they may straddle two.
+  enum { prefetch_stride =
+         __eytzinger_pow2_floor<__STL_CACHE_LINE_SIZE / sizeof(T)>::value };
+
+  T* data;                      // data[0] is never constructed
+  size_type n;
+  Compare comp;
+
+  T* allocate(size_type sz) {
+    return sz == 0 ? 0 : data_allocator::allocate(sz + 1);
+  }
+  void deallocate() { if (data) data_allocator::deallocate(data, n + 1); }
+  void destroy_first(size_type m) {
+    const_iterator it = begin();
+    for ( ; m != 0; --m, ++it)
+      destroy(data + it.k);
+  }
+
+#ifndef __STL_MEMBER_TEMPLATES
+  typedef const value_type* ForwardIterator;
+#endif /* __STL_MEMBER_TEMPLATES */
+
+  // Constructs the subtree rooted at k from the next elements of first;
+  // m counts the elements constructed so far.
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class ForwardIterator>
+#endif /* __STL_MEMBER_TEMPLATES */
+  void fill_subtree(ForwardIterator& first, size_type k, size_type& m) {
+    while (k <= n) {
+      fill_subtree(first, 2 * k, m);
+      construct(data + k, *first);
+      ++first;
+      ++m;
+      k = 2 * k + 1;
+    }
+  }
+
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class ForwardIterator>
+#endif /* __STL_MEMBER_TEMPLATES */
+  void initialize(ForwardIterator first, ForwardIterator last) {
+    n = 0;
+    distance(first, last, n);
+    data = allocate(n);
+    size_type m = 0;
+    __STL_TRY {
+      fill_subtree(first, 1, m);
+    }
+    __STL_UNWIND((destroy_first(m), deallocate()));
+  }
+
+  // A search ends below the answer j after one left turn followed only
+  // by right turns; undo those to recover j (0, i.e. end(), if the
+  // search never turned left).
+  static size_type finish_search(size_type k) {
+    while (k & 1)
+      k >>= 1;
+    return k >> 1;
+  }
+
+public:
+  eytzinger_array() : data(0), n(0), comp(Compare()) {}
+
+  // [first, last) must be sorted with respect to comp.
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class ForwardIterator>
+  eytzinger_array(ForwardIterator first, ForwardIterator last,
+                  const Compare& c = Compare())
+    : comp(c) { initialize(first, last); }
+#else
+  eytzinger_array(const value_type* first, const value_type* last,
+                  const Compare& c = Compare())
+    : comp(c) { initialize(first, last); }
+#endif /* __STL_MEMBER_TEMPLATES */
+
+  eytzinger_array(const eytzinger_array<T, Compare, Alloc>& x)
+    : n(x.n), comp(x.comp) {
+    data = allocate(n);
+    if (data) {
+      __STL_TRY {
+        uninitialized_copy(x.data + 1, x.data + n + 1, data + 1);
+      }
+      __STL_UNWIND(deallocate());
+    }
+  }
+  eytzinger_array<T, Compare, Alloc>&
+  operator=(const eytzinger_array<T, Compare, Alloc>& x) {
+    if (this != &x) {
+      eytzinger_array<T, Compare, Alloc> tmp(x);
+      swap(tmp);
+    }
+    return *this;
+  }
+  ~eytzinger_array() {
+    if (data) {
+      destroy(data + 1, data + n + 1);
+      deallocate();
+    }
+  }
+
+  key_compare key_comp() const { return comp; }
+  const_iterator begin() const {
+    size_type k = n == 0 ? 0 : 1;
+    while (2 * k <= n && k != 0)
+      k = 2 * k;
+    return const_iterator(data, k, n);
+  }
+  const_iterator end() const { return const_iterator(data, 0, n); }
+  bool empty() const { return n == 0; }
+  size_type size() const { return n; }
+  size_type max_size() const { return size_type(-1) / sizeof(T) - 1; }
+  void swap(eytzinger_array<T, Compare, Alloc>& x) {
+    __STD::swap(data, x.data);
+    __STD::swap(n, x.n);
+    __STD::swap(comp, x.comp);
+  }
+
+                                // search operations:
+
+  const_iterator lower_bound(const value_type& x) const {
+    size_type k = 1;
+    while (k <= n) {
+      __STL_PREFETCH(data + min(k * prefetch_stride, n));
+      k = 2 * k + (comp(data[k], x) ? 1 : 0);
+    }
+    return const_iterator(data, finish_search(k), n);
+  }
+  const_iterator upper_bound(const value_type& x) const {
+    size_type k = 1;
+    while (k <= n) {
+      __STL_PREFETCH(data + min(k * prefetch_stride, n));
+      k = 2 * k + (comp(x, data[k]) ? 0 : 1);
+    }
+    return const_iterator(data, finish_search(k), n);
+  }
+  pair<const_iterator, const_iterator>
+  equal_range(const value_type& x) const {
+    return pair<const_iterator, const_iterator>(lower_bound(x),
+                                                upper_bound(x));
+  }
+  bool binary_search(const value_type& x) const {
+    const_iterator i = lower_bound(x);
+    return i != end() && !comp(x, *i);
+  }
+  const_iterator find(const value_type& x) const {
+    const_iterator i = lower_bound(x);
+    return (i == end() || comp(x, *i)) ? end() : i;
+  }
+  size_type count(const value_type& x) const {
+    pair<const_iterator, const_iterator> p = equal_range(x);
+    size_type result = 0;
+    distance(p.first, p.second, result);
+    return result;
+  }
+};
+
+template <class T, class Compare, class Alloc>
+inline bool operator==(const eytzinger_array<T, Compare, Alloc>& x,
+                       const eytzinger_array<T, Compare, Alloc>& y) {
+  return x.size() == y.size() && equal(x.begin(), x.end(), y.begin());
+}
+
+template <class T, class Compare, class Alloc>
+inline bool operator<(const eytzinger_array<T, Compare, Alloc>& x,
+                      const eytzinger_array<T, Compare, Alloc>& y) {
+  return lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+#ifdef __STL_FUNCTION_TMPL_PARTIAL_ORDER
+
+template <class T, class Compare, class Alloc>
+inline void swap(eytzinger_array<T, Compare, Alloc>& x,
+                 eytzinger_array<T, Compare, Alloc>& y) {
+  x.swap(y);
+}
+
+#endif /* __STL_FUNCTION_TMPL_PARTIAL_ORDER */
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma reset woff 1174
+#endif
+
+__STL_END_NAMESPACE
+
+#endif /* __SGI_STL_INTERNAL_EYTZINGER_H */
+
+// Local Variables:
+// mode:C++
+// End:
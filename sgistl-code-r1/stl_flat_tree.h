@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 1997
+ * Silicon Graphics Computer Systems, Inc.
+ *
+ * Permission to use, copy, modify, distribute and sell this software
+ * and its documentation for any purpose is hereby granted without fee,
+ * provided that the above copyright notice appear in all copies and
+ * that both that copyright notice and this permission notice appear
+ * in supporting documentation.  Silicon Graphics makes no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ */
+
+/* NOTE: This is an internal header file, included by other STL headers.
+ *   You should not attempt to use it directly.
+ */
+
+#ifndef __SGI_STL_INTERNAL_FLAT_TREE_H
+#define __SGI_STL_INTERNAL_FLAT_TREE_H
+
+/*
+
+Sorted-vector class, designed for use in implementing flat_set and
+flat_map.  It plays the part rb_tree plays for set and map: the
+elements are kept sorted and unique in a vector, so lookups are binary
+searches over contiguous storage and there is no per-element node.
+
+Inserting or erasing a single element is linear.  Ranges are inserted
+in one batch: the new elements are appended, sorted, and merged with
+the existing ones, which costs O(n + m log m) rather than O(n m).
+Any insertion or erasure invalidates all iterators.
+
+*/
+
+#include <stl_algobase.h>
+#include <stl_alloc.h>
+#include <stl_construct.h>
+#include <stl_tempbuf.h>
+#include <stl_algo.h>
+#include <stl_uninitialized.h>
+#include <stl_function.h>
+#include <stl_vector.h>
+
+__STL_BEGIN_NAMESPACE
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma set woff 1174
+#endif
+
+// Adaptors from a key comparison to the argument orders used by
+// __lower_bound, __upper_bound, sort and unique.
+
+template <class Key, class Value, class KeyOfValue, class Compare>
+struct __flat_value_key_compare {
+  Compare comp;
+  __flat_value_key_compare(const Compare& c) : comp(c) {}
+  bool operator()(const Value& x, const Key& k) const {
+    return comp(KeyOfValue()(x), k);
+  }
+};
+
+template <class Key, class Value, class KeyOfValue, class Compare>
+struct __flat_key_value_compare {
+  Compare comp;
+  __flat_key_value_compare(const Compare& c) : comp(c) {}
+  bool operator()(const Key& k, const Value& x) const {
+    return comp(k, KeyOfValue()(x));
+  }
+};
+
+template <class Value, class KeyOfValue, class Compare>
+struct __flat_value_compare {
+  Compare comp;
+  __flat_value_compare(const Compare& c) : comp(c) {}
+  bool operator()(const Value& x, const Value& y) const {
+    return comp(KeyOfValue()(x), KeyOfValue()(y));
+  }
+};
+
+// Equivalence of two elements already known to be in order.
+template <class Value, class KeyOfValue, class Compare>
+struct __flat_sorted_equiv {
+  Compare comp;
+  __flat_sorted_equiv(const Compare& c) : comp(c) {}
+  bool operator()(const Value& x, const Value& y) const {
+    return !comp(KeyOfValue()(x), KeyOfValue()(y));
+  }
+};
+
+template <class Key, class Value, class KeyOfValue, class Compare,
+          class Alloc = alloc>
+class __flat_tree {
+protected:
+  typedef vector<Value, Alloc> rep_type;
+  typedef __flat_value_key_compare<Key, Value, KeyOfValue, Compare>
+          value_key_compare;
+  typedef __flat_key_value_compare<Key, Value, KeyOfValue, Compare>
+          key_value_compare;
+  typedef __flat_value_compare<Value, KeyOfValue, Compare> value_compare;
+  typedef __flat_sorted_equiv<Value, KeyOfValue, Compare> sorted_equiv;
+public:
+  typedef Key key_type;
+  typedef Value value_type;
+  typedef typename rep_type::pointer pointer;
+  typedef typename rep_type::const_pointer const_pointer;
+  typedef typename rep_type::reference reference;
+  typedef typename rep_type::const_reference const_reference;
+  typedef typename rep_type::iterator iterator;
+  typedef typename rep_type::const_iterator const_iterator;
+  typedef typename rep_type::reverse_iterator reverse_iterator;
+  typedef typename rep_type::const_reverse_iterator const_reverse_iterator;
+  typedef typename rep_type::size_type size_type;
+  typedef typename rep_type::difference_type difference_type;
+
+protected:
+  rep_type c;
+  Compare key_compare;
+
+  const Key& key(const Value& x) const { return KeyOfValue()(x); }
+
+  // [begin(), begin() + n) is sorted and unique; sort what follows and
+  // merge it in, keeping the existing element on equal keys.
+  void merge_unique(size_type n);
+
+public:
+                                // allocation/deallocation
+  __flat_tree(const Compare& comp = Compare()) : key_compare(comp) {}
+
+public:
+                                // accessors:
+  Compare key_comp() const { return key_compare; }
+  iterator begin() { return c.begin(); }
+  const_iterator begin() const { return c.begin(); }
+  iterator end() { return c.end(); }
+  const_iterator end() const { return c.end(); }
+  reverse_iterator rbegin() { return c.rbegin(); }
+  const_reverse_iterator rbegin() const { return c.rbegin(); }
+  reverse_iterator rend() { return c.rend(); }
+  const_reverse_iterator rend() const { return c.rend(); }
+  bool empty() const { return c.empty(); }
+  size_type size() const { return c.size(); }
+  size_type max_size() const { return c.max_size(); }
+  size_type capacity() const { return c.capacity(); }
+  void reserve(size_type n) { c.reserve(n); }
+  void shrink_to_fit() {
+    if (c.capacity() != c.size())
+      rep_type(c).swap(c);
+  }
+
+  void swap(__flat_tree<Key, Value, KeyOfValue, Compare, Alloc>& t) {
+    c.swap(t.c);
+    __STD::swap(key_compare, t.key_compare);
+  }
+
+public:
+                                // insert/erase
+  pair<iterator,bool> insert_unique(const value_type& x);
+  iterator insert_unique(iterator position, const value_type& x);
+
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class InputIterator>
+  void insert_unique(InputIterator first, InputIterator last) {
+    size_type n = size();
+    c.insert(c.end(), first, last);
+    merge_unique(n);
+  }
+#else /* __STL_MEMBER_TEMPLATES */
+  // const_iterator is const value_type*, so this covers arrays too.
+  void insert_unique(const_iterator first, const_iterator last) {
+    size_type n = size();
+    c.insert(c.end(), first, last);
+    merge_unique(n);
+  }
+#endif /* __STL_MEMBER_TEMPLATES */
+
+  void erase(iterator position) { c.erase(position); }
+  size_type erase(const key_type& x);
+  void erase(iterator first, iterator last) { c.erase(first, last); }
+  void clear() { c.clear(); }
+
+public:
+                                // set operations:
+  iterator find(const key_type& x) {
+    iterator j = lower_bound(x);
+    return (j == end() || key_compare(x, key(*j))) ? end() : j;
+  }
+  const_iterator find(const key_type& x) const {
+    const_iterator j = lower_bound(x);
+    return (j == end() || key_compare(x, key(*j))) ? end() : j;
+  }
+  size_type count(const key_type& x) const {
+    return find(x) == end() ? 0 : 1;
+  }
+  iterator lower_bound(const key_type& x) {
+    return __lower_bound(begin(), end(), x, value_key_compare(key_compare),
+                         (difference_type*)0, random_access_iterator_tag());
+  }
+  const_iterator lower_bound(const key_type& x) const {
+    return __lower_bound(begin(), end(), x, value_key_compare(key_compare),
+                         (difference_type*)0, random_access_iterator_tag());
+  }
+  iterator upper_bound(const key_type& x) {
+    return __upper_bound(begin(), end(), x, key_value_compare(key_compare),
+                         (difference_type*)0, random_access_iterator_tag());
+  }
+  const_iterator upper_bound(const key_type& x) const {
+    return __upper_bound(begin(), end(), x, key_value_compare(key_compare),
+                         (difference_type*)0, random_access_iterator_tag());
+  }
+  pair<iterator,iterator> equal_range(const key_type& x) {
+    iterator first = lower_bound(x);
+    iterator last = first;
+    if (last != end() && !key_compare(x, key(*last)))
+      ++last;
+    return pair<iterator,iterator>(first, last);
+  }
+  pair<const_iterator,const_iterator> equal_range(const key_type& x) const {
+    const_iterator first = lower_bound(x);
+    const_iterator last = first;
+    if (last != end() && !key_compare(x, key(*last)))
+      ++last;
+    return pair<const_iterator,const_iterator>(first, last);
+  }
+};
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+inline bool
+operator==(const __flat_tree<Key, Value, KeyOfValue, Compare, Alloc>& x,
+           const __flat_tree<Key, Value, KeyOfValue, Compare, Alloc>& y) {
+  return x.size() == y.size() && equal(x.begin(), x.end(), y.begin());
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+inline bool
+operator<(const __flat_tree<Key, Value, KeyOfValue, Compare, Alloc>& x,
+          const __flat_tree<Key, Value, KeyOfValue, Compare, Alloc>& y) {
+  return lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+void
+__flat_tree<Key, Value, KeyOfValue, Compare, Alloc>::merge_unique(size_type n)
+{
+  iterator mid = begin() + n;
+  if (mid == end())
+    return;
+  value_compare comp(key_compare);
+  if (!is_sorted(mid, end(), comp))
+    stable_sort(mid, end(), comp);
+  iterator first = mid;
+  if (mid != begin() && !key_compare(key(*(mid - 1)), key(*mid))) {
+    // The new elements do not simply extend the old ones.
+    first = __upper_bound(begin(), mid, key(*mid),
+                          key_value_compare(key_compare),
+                          (difference_type*)0, random_access_iterator_tag());
+    inplace_merge(first, mid, end(), comp);
+    if (first != begin())
+      --first;
+  }
+  c.erase(unique(first, end(), sorted_equiv(key_compare)), end());
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+pair<typename __flat_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator,
+     bool>
+__flat_tree<Key, Value, KeyOfValue, Compare, Alloc>::
+insert_unique(const Value& v)
+{
+  iterator j = lower_bound(key(v));
+  if (j != end() && !key_compare(key(v), key(*j)))
+    return pair<iterator,bool>(j, false);
+  return pair<iterator,bool>(c.insert(j, v), true);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename __flat_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
+__flat_tree<Key, Value, KeyOfValue, Compare, Alloc>::
+insert_unique(iterator position, const Value& v)
+{
+                                // v belongs right before position?
+  if ((position == begin() || key_compare(key(*(position - 1)), key(v)))
+      && (position == end() || key_compare(key(v), key(*position))))
+    return c.insert(position, v);
+  return insert_unique(v).first;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename __flat_tree<Key, Value, KeyOfValue, Compare, Alloc>::size_type
+__flat_tree<Key, Value, KeyOfValue, Compare, Alloc>::erase(const Key& x)
+{
+  iterator j = find(x);
+  if (j == end())
+    return 0;
+  c.erase(j);
+  return 1;
+}
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma reset woff 1174
+#endif
+
+__STL_END_NAMESPACE
+
+#endif /* __SGI_STL_INTERNAL_FLAT_TREE_H */
+
+// Local Variables:
+// mode:C++
+// End:
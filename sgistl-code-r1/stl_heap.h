@@ -213,6 +213,211 @@ void sort_heap(RandomAccessIterator first, RandomAccessIterator last,
   while (last - first > 1) pop_heap(first, last--, comp);
 }
 
+// d-ary heaps.  In a heap of arity d the children of element i are the
+// d consecutive elements starting at d * i + 1, so for d = 4 or 8 and
+// small elements all of a node's children share one or two cache lines
+// and a heap of n elements has log_d(n) levels rather than log_2(n).
+// Popping compares more children per level, but on heaps too large for
+// the cache it is the number of levels, each a likely cache miss, that
+// costs.  The arity is given explicitly, as in push_dary_heap<4>(first,
+// last), and all the functions applied to one range must agree on it.
+// With an arity of 2 they arrange elements exactly as the binary heap
+// functions above do.
+
+// An arity of 0 is rejected at compile time: __dary_arity<0> is never
+// defined.
+template <size_t Arity>
+struct __dary_arity { enum { value = Arity }; };
+__STL_TEMPLATE_NULL struct __dary_arity<0>;
+
+template <size_t Arity, class RandomAccessIterator, class Distance, class T>
+void __dary_push_heap(RandomAccessIterator first, Distance holeIndex,
+                      Distance topIndex, T value) {
+  const Distance arity = __dary_arity<Arity>::value;
+  Distance parent = (holeIndex - 1) / arity;
+  while (holeIndex > topIndex && *(first + parent) < value) {
+    *(first + holeIndex) = *(first + parent);
+    holeIndex = parent;
+    parent = (holeIndex - 1) / arity;
+  }
+  *(first + holeIndex) = value;
+}
+
+template <size_t Arity, class RandomAccessIterator, class Distance, class T,
+          class Compare>
+void __dary_push_heap(RandomAccessIterator first, Distance holeIndex,
+                      Distance topIndex, T value, Compare comp) {
+  const Distance arity = __dary_arity<Arity>::value;
+  Distance parent = (holeIndex - 1) / arity;
+  while (holeIndex > topIndex && comp(*(first + parent), value)) {
+    *(first + holeIndex) = *(first + parent);
+    holeIndex = parent;
+    parent = (holeIndex - 1) / arity;
+  }
+  *(first + holeIndex) = value;
+}
+
+template <size_t Arity, class RandomAccessIterator, class Distance, class T>
+inline void __dary_push_heap_aux(RandomAccessIterator first,
+                                 RandomAccessIterator last, Distance*, T*) {
+  __dary_push_heap<Arity>(first, Distance((last - first) - 1), Distance(0),
+                          T(*(last - 1)));
+}
+
+template <size_t Arity, class RandomAccessIterator, class Compare,
+          class Distance, class T>
+inline void __dary_push_heap_aux(RandomAccessIterator first,
+                                 RandomAccessIterator last, Compare comp,
+                                 Distance*, T*) {
+  __dary_push_heap<Arity>(first, Distance((last - first) - 1), Distance(0),
+                          T(*(last - 1)), comp);
+}
+
+template <size_t Arity, class RandomAccessIterator>
+inline void push_dary_heap(RandomAccessIterator first,
+                           RandomAccessIterator last) {
+  __dary_push_heap_aux<Arity>(first, last, distance_type(first),
+                              value_type(first));
+}
+
+template <size_t Arity, class RandomAccessIterator, class Compare>
+inline void push_dary_heap(RandomAccessIterator first,
+                           RandomAccessIterator last, Compare comp) {
+  __dary_push_heap_aux<Arity>(first, last, comp, distance_type(first),
+                              value_type(first));
+}
+
+// Like __adjust_heap, moves the hole down to a leaf along the largest
+// children, the last of equal ones, and then pushes value up from there.
+template <size_t Arity, class RandomAccessIterator, class Distance, class T>
+void __dary_adjust_heap(RandomAccessIterator first, Distance holeIndex,
+                        Distance len, T value) {
+  const Distance arity = __dary_arity<Arity>::value;
+  Distance topIndex = holeIndex;
+  Distance child = arity * holeIndex + 1;
+  while (child < len) {
+    Distance best = child;
+    Distance end = child + arity < len ? child + arity : len;
+    for (++child; child < end; ++child)
+      if (!(*(first + child) < *(first + best)))
+        best = child;
+    *(first + holeIndex) = *(first + best);
+    holeIndex = best;
+    child = arity * holeIndex + 1;
+  }
+  __dary_push_heap<Arity>(first, holeIndex, topIndex, value);
+}
+
+template <size_t Arity, class RandomAccessIterator, class Distance, class T,
+          class Compare>
+void __dary_adjust_heap(RandomAccessIterator first, Distance holeIndex,
+                        Distance len, T value, Compare comp) {
+  const Distance arity = __dary_arity<Arity>::value;
+  Distance topIndex = holeIndex;
+  Distance child = arity * holeIndex + 1;
+  while (child < len) {
+    Distance best = child;
+    Distance end = child + arity < len ? child + arity : len;
+    for (++child; child < end; ++child)
+      if (!comp(*(first + child), *(first + best)))
+        best = child;
+    *(first + holeIndex) = *(first + best);
+    holeIndex = best;
+    child = arity * holeIndex + 1;
+  }
+  __dary_push_heap<Arity>(first, holeIndex, topIndex, value, comp);
+}
+
+template <size_t Arity, class RandomAccessIterator, class T, class Distance>
+inline void __dary_pop_heap_aux(RandomAccessIterator first,
+                                RandomAccessIterator last, T*, Distance*) {
+  T value = *(last - 1);
+  *(last - 1) = *first;
+  __dary_adjust_heap<Arity>(first, Distance(0), Distance((last - first) - 1),
+                            value);
+}
+
+template <size_t Arity, class RandomAccessIterator, class T, class Compare,
+          class Distance>
+inline void __dary_pop_heap_aux(RandomAccessIterator first,
+                                RandomAccessIterator last, T*, Compare comp,
+                                Distance*) {
+  T value = *(last - 1);
+  *(last - 1) = *first;
+  __dary_adjust_heap<Arity>(first, Distance(0), Distance((last - first) - 1),
+                            value, comp);
+}
+
+template <size_t Arity, class RandomAccessIterator>
+inline void pop_dary_heap(RandomAccessIterator first,
+                          RandomAccessIterator last) {
+  __dary_pop_heap_aux<Arity>(first, last, value_type(first),
+                             distance_type(first));
+}
+
+template <size_t Arity, class RandomAccessIterator, class Compare>
+inline void pop_dary_heap(RandomAccessIterator first,
+                          RandomAccessIterator last, Compare comp) {
+  __dary_pop_heap_aux<Arity>(first, last, value_type(first), comp,
+                             distance_type(first));
+}
+
+template <size_t Arity, class RandomAccessIterator, class T, class Distance>
+void __dary_make_heap(RandomAccessIterator first, RandomAccessIterator last,
+                      T*, Distance*) {
+  const Distance arity = __dary_arity<Arity>::value;
+  if (last - first < 2) return;
+  Distance len = last - first;
+  Distance parent = (len - 2) / arity;
+
+  while (true) {
+    __dary_adjust_heap<Arity>(first, parent, len, T(*(first + parent)));
+    if (parent == 0) return;
+    parent--;
+  }
+}
+
+template <size_t Arity, class RandomAccessIterator, class Compare, class T,
+          class Distance>
+void __dary_make_heap(RandomAccessIterator first, RandomAccessIterator last,
+                      Compare comp, T*, Distance*) {
+  const Distance arity = __dary_arity<Arity>::value;
+  if (last - first < 2) return;
+  Distance len = last - first;
+  Distance parent = (len - 2) / arity;
+
+  while (true) {
+    __dary_adjust_heap<Arity>(first, parent, len, T(*(first + parent)), comp);
+    if (parent == 0) return;
+    parent--;
+  }
+}
+
+template <size_t Arity, class RandomAccessIterator>
+inline void make_dary_heap(RandomAccessIterator first,
+                           RandomAccessIterator last) {
+  __dary_make_heap<Arity>(first, last, value_type(first),
+                          distance_type(first));
+}
+
+template <size_t Arity, class RandomAccessIterator, class Compare>
+inline void make_dary_heap(RandomAccessIterator first,
+                           RandomAccessIterator last, Compare comp) {
+  __dary_make_heap<Arity>(first, last, comp, value_type(first),
+                          distance_type(first));
+}
+
+template <size_t Arity, class RandomAccessIterator>
+void sort_dary_heap(RandomAccessIterator first, RandomAccessIterator last) {
+  while (last - first > 1) pop_dary_heap<Arity>(first, last--);
+}
+
+template <size_t Arity, class RandomAccessIterator, class Compare>
+void sort_dary_heap(RandomAccessIterator first, RandomAccessIterator last,
+                    Compare comp) {
+  while (last - first > 1) pop_dary_heap<Arity>(first, last--, comp);
+}
+
 #if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
 #pragma reset woff 1209
 #endif
@@ -610,6 +610,15 @@ void list<T, Alloc>::sort(StrictWeakOrdering comp) {
 
 __STL_END_NAMESPACE 
 
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+
+template <class T, class Alloc>
+struct __relocate_traits<__STD::list<T, Alloc> > {
+  typedef __true_type is_trivially_relocatable;
+};
+
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
 #endif /* __SGI_STL_INTERNAL_LIST_H */
 
 // Local Variables:
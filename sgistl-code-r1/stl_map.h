@@ -152,6 +152,22 @@ public:
     t.insert_unique(first, last);
   }
 #endif /* __STL_MEMBER_TEMPLATES */
+  // append_sorted: [first, last) is sorted and every element sorts
+  // after the current contents, so each costs one comparison.  Elements
+  // that do not are inserted as by insert().
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class InputIterator>
+  void append_sorted(InputIterator first, InputIterator last) {
+    t.append_unique(first, last);
+  }
+#else
+  void append_sorted(const value_type* first, const value_type* last) {
+    t.append_unique(first, last);
+  }
+  void append_sorted(const_iterator first, const_iterator last) {
+    t.append_unique(first, last);
+  }
+#endif /* __STL_MEMBER_TEMPLATES */
 
   void erase(iterator position) { t.erase(position); }
   size_type erase(const key_type& x) { return t.erase(x); }
@@ -210,6 +226,15 @@ inline void swap(map<Key, T, Compare, Alloc>& x,
 
 __STL_END_NAMESPACE
 
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+
+template <class Key, class T, class Compare, class Alloc>
+struct __relocate_traits<__STD::map<Key, T, Compare, Alloc> > {
+  typedef __true_type is_trivially_relocatable;
+};
+
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
 #endif /* __SGI_STL_INTERNAL_MAP_H */
 
 // Local Variables:
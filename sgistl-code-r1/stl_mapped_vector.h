@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 1997
+ * Silicon Graphics Computer Systems, Inc.
+ *
+ * Permission to use, copy, modify, distribute and sell this software
+ * and its documentation for any purpose is hereby granted without fee,
+ * provided that the above copyright notice appear in all copies and
+ * that both that copyright notice and this permission notice appear
+ * in supporting documentation.  Silicon Graphics makes no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ */
+
+/* NOTE: This is an internal header file, included by other STL headers.
+ *   You should not attempt to use it directly.
+ */
+
+#ifndef __SGI_STL_INTERNAL_MAPPED_VECTOR_H
+#define __SGI_STL_INTERNAL_MAPPED_VECTOR_H
+
+/*
+
+Vector of PODs whose storage is a memory-mapped file.
+
+open() maps the file (creating it if necessary) and the elements it
+already holds are available at once; nothing is read or converted.  The
+file starts with a small header recording the element size and the
+number of elements, followed by the elements themselves at data_offset.
+Growth extends the file with ftruncate and remaps it, with mremap where
+the system has it.  Changes reach the file as the system writes back
+the pages; sync() forces them out, and close() (or the destructor)
+unmaps the file.
+
+The file is in the host's native layout and is only meaningful to a
+mapped_vector of the same element type on the same kind of machine.
+The element type must be a POD: elements are moved with memmove, never
+constructed or destroyed.  A mapped_vector must be open before it is
+modified, and it cannot be copied.
+
+*/
+
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+__STL_BEGIN_NAMESPACE
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma set woff 1174
+#endif
+
+template <class T>
+class mapped_vector {
+public:
+  typedef T value_type;
+  typedef value_type* pointer;
+  typedef const value_type* const_pointer;
+  typedef value_type* iterator;
+  typedef const value_type* const_iterator;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+  typedef reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef reverse_iterator<iterator> reverse_iterator;
+#else /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+  typedef reverse_iterator<const_iterator, value_type, const_reference,
+                           difference_type>  const_reverse_iterator;
+  typedef reverse_iterator<iterator, value_type, reference, difference_type>
+          reverse_iterator;
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
+protected:
+  struct header {
+    unsigned long magic;
+    unsigned long element_size;
+    unsigned long count;
+  };
+  enum { data_offset = 64 };
+  static unsigned long file_magic() { return 0x4d564543UL; }   // "MVEC"
+
+  int fd;
+  char* base;                   // the whole mapping; the header is first
+  size_type mapped;             // its length in bytes
+  iterator start;
+  iterator finish;
+  iterator end_of_storage;
+
+  header* hdr() const { return (header*) base; }
+  void set_finish(iterator p) {
+    finish = p;
+    hdr()->count = finish - start;
+  }
+  static size_type page_round(size_type bytes) {
+    const size_type page = sysconf(_SC_PAGESIZE);
+    return (bytes + page - 1) / page * page;
+  }
+  void map_storage(size_type bytes);
+  void grow(size_type n) {      // room for at least n more elements
+    const size_type old_size = size();
+    const size_type len = old_size + max(old_size, n);
+    map_storage(page_round(data_offset + len * sizeof(T)));
+  }
+
+private:
+  mapped_vector(const mapped_vector<T>&);
+  mapped_vector<T>& operator=(const mapped_vector<T>&);
+
+public:
+  mapped_vector()
+    : fd(-1), base(0), mapped(0), start(0), finish(0), end_of_storage(0) {}
+  explicit mapped_vector(const char* path)
+    : fd(-1), base(0), mapped(0), start(0), finish(0), end_of_storage(0) {
+    open(path);
+  }
+  ~mapped_vector() { close(); }
+
+  // Maps path, creating an empty vector there if the file is new or
+  // empty.  Returns false, leaving *this closed, if the file cannot be
+  // opened or mapped or holds something other than a vector of T.
+  bool open(const char* path);
+  void close() {
+    if (base) {
+      munmap(base, mapped);
+      ::close(fd);
+      fd = -1;
+      base = 0;
+      mapped = 0;
+      start = finish = end_of_storage = 0;
+    }
+  }
+  bool is_open() const { return base != 0; }
+  void sync() { if (base) msync(base, mapped, MS_SYNC); }
+
+  iterator begin() { return start; }
+  const_iterator begin() const { return start; }
+  iterator end() { return finish; }
+  const_iterator end() const { return finish; }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+  size_type size() const { return size_type(end() - begin()); }
+  size_type max_size() const { return size_type(-1) / sizeof(T); }
+  size_type capacity() const { return size_type(end_of_storage - begin()); }
+  bool empty() const { return begin() == end(); }
+  reference operator[](size_type n) { return *(begin() + n); }
+  const_reference operator[](size_type n) const { return *(begin() + n); }
+  reference front() { return *begin(); }
+  const_reference front() const { return *begin(); }
+  reference back() { return *(end() - 1); }
+  const_reference back() const { return *(end() - 1); }
+
+  void reserve(size_type n) {
+    if (capacity() < n)
+      map_storage(page_round(data_offset + n * sizeof(T)));
+  }
+  void push_back(const T& x) {
+    if (finish == end_of_storage) {
+      const T x_copy = x;       // x may live in the mapping
+      grow(1);
+      *finish = x_copy;
+    }
+    else
+      *finish = x;
+    set_finish(finish + 1);
+  }
+  void pop_back() { set_finish(finish - 1); }
+
+  iterator insert(iterator position, size_type n, const T& x);
+  iterator insert(iterator position, const T& x) {
+    return insert(position, 1, x);
+  }
+  iterator insert(iterator position, const_iterator first,
+                  const_iterator last);
+  iterator erase(iterator first, iterator last) {
+    memmove(first, last, (finish - last) * sizeof(T));
+    set_finish(finish - (last - first));
+    return first;
+  }
+  iterator erase(iterator position) { return erase(position, position + 1); }
+
+  void resize(size_type new_size, const T& x) {
+    if (new_size < size())
+      erase(begin() + new_size, end());
+    else
+      insert(end(), new_size - size(), x);
+  }
+  void resize(size_type new_size) { resize(new_size, T()); }
+  // Like resize(new_size), but new elements keep whatever the file holds.
+  void resize_default_init(size_type new_size) {
+    if (new_size > capacity())
+      grow(new_size - size());
+    set_finish(start + new_size);
+  }
+  void clear() { set_finish(start); }
+};
+
+template <class T>
+bool mapped_vector<T>::open(const char* path)
+{
+  close();
+  int f = ::open(path, O_RDWR | O_CREAT, 0666);
+  if (f < 0)
+    return false;
+  struct stat st;
+  size_type bytes = 0;
+  bool ok = fstat(f, &st) == 0;
+  if (ok) {
+    bytes = st.st_size;
+    if (bytes == 0) {
+      bytes = page_round(data_offset);
+      ok = ftruncate(f, bytes) == 0;
+    }
+    else
+      ok = bytes >= (size_type) data_offset;
+  }
+  void* p = ok ? mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, f, 0)
+               : MAP_FAILED;
+  if (p == MAP_FAILED) {
+    ::close(f);
+    return false;
+  }
+  header* h = (header*) p;
+  const size_type cap = (bytes - data_offset) / sizeof(T);
+  if (h->magic == 0 && h->element_size == 0 && h->count == 0) {
+    h->magic = file_magic();
+    h->element_size = sizeof(T);
+  }
+  else if (h->magic != file_magic() || h->element_size != sizeof(T)
+           || h->count > cap) {
+    munmap(p, bytes);
+    ::close(f);
+    return false;
+  }
+  fd = f;
+  base = (char*) p;
+  mapped = bytes;
+  start = (T*) (base + data_offset);
+  finish = start + h->count;
+  end_of_storage = start + cap;
+  return true;
+}
+
+template <class T>
+void mapped_vector<T>::map_storage(size_type bytes)
+{
+  const size_type n = size();
+  if (ftruncate(fd, bytes) != 0) {
+    __THROW_BAD_ALLOC;
+  }
+#ifdef MREMAP_MAYMOVE
+  void* p = mremap(base, mapped, bytes, MREMAP_MAYMOVE);
+#else /* MREMAP_MAYMOVE */
+  void* p = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (p != MAP_FAILED)
+    munmap(base, mapped);
+#endif /* MREMAP_MAYMOVE */
+  if (p == MAP_FAILED) {        // the old mapping is still in place
+    __THROW_BAD_ALLOC;
+  }
+  base = (char*) p;
+  mapped = bytes;
+  start = (T*) (base + data_offset);
+  finish = start + n;
+  end_of_storage = start + (bytes - data_offset) / sizeof(T);
+}
+
+template <class T>
+typename mapped_vector<T>::iterator
+mapped_vector<T>::insert(iterator position, size_type n, const T& x)
+{
+  const size_type off = position - start;
+  if (n == 0)
+    return position;
+  const T x_copy = x;
+  if (size_type(end_of_storage - finish) < n)
+    grow(n);
+  position = start + off;
+  memmove(position + n, position, (finish - position) * sizeof(T));
+  fill_n(position, n, x_copy);
+  set_finish(finish + n);
+  return position;
+}
+
+template <class T>
+typename mapped_vector<T>::iterator
+mapped_vector<T>::insert(iterator position, const_iterator first,
+                         const_iterator last)
+{
+  const size_type off = position - start;
+  const size_type n = last - first;
+  if (n == 0)
+    return position;
+  if (size_type(end_of_storage - finish) < n) {
+    if (first >= start && first < end_of_storage) {
+      // The source is in the mapping, which grow may move.
+      const size_type src = first - start;
+      grow(n);
+      first = start + src;
+    }
+    else
+      grow(n);
+  }
+  position = start + off;
+  memmove(position + n, position, (finish - position) * sizeof(T));
+  if (first >= position && first < finish) {
+    first += n;                 // the source moved along with the tail
+    memmove(position, first, n * sizeof(T));
+  }
+  else if (first < position && position < first + n) {
+    // The source straddles position, so it was split by the memmove.
+    const size_type head = position - first;
+    memmove(position, first, head * sizeof(T));
+    memmove(position + head, position + n, (n - head) * sizeof(T));
+  }
+  else
+    memmove(position, first, n * sizeof(T));
+  set_finish(finish + n);
+  return position;
+}
+
+template <class T>
+inline bool operator==(const mapped_vector<T>& x, const mapped_vector<T>& y) {
+  return x.size() == y.size() && equal(x.begin(), x.end(), y.begin());
+}
+
+template <class T>
+inline bool operator<(const mapped_vector<T>& x, const mapped_vector<T>& y) {
+  return lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma reset woff 1174
+#endif
+
+__STL_END_NAMESPACE
+
+#endif /* __SGI_STL_INTERNAL_MAPPED_VECTOR_H */
+
+// Local Variables:
+// mode:C++
+// End:
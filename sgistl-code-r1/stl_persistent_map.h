@@ -0,0 +1,813 @@
+/*
+ * Copyright (c) 1997
+ * Silicon Graphics Computer Systems, Inc.
+ *
+ * Permission to use, copy, modify, distribute and sell this software
+ * and its documentation for any purpose is hereby granted without fee,
+ * provided that the above copyright notice appear in all copies and
+ * that both that copyright notice and this permission notice appear
+ * in supporting documentation.  Silicon Graphics makes no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ */
+
+/* NOTE: This is an internal header file, included by other STL headers.
+ *   You should not attempt to use it directly.
+ */
+
+#ifndef __SGI_STL_INTERNAL_PERSISTENT_MAP_H
+#define __SGI_STL_INTERNAL_PERSISTENT_MAP_H
+
+/*
+
+Persistent (immutable, path-copying) ordered map.
+
+Nodes are red-black tree nodes without parent links, shared between
+versions and reference counted in the same way as rope nodes.  A node
+is never modified once it is reachable from a map, so copying a
+persistent_map is O(1) and yields a snapshot that later updates of the
+original cannot disturb.  insert and erase copy only the nodes on the
+search path, O(log n) of them.
+
+Without parent links the bottom-up rebalancing of __rb_tree_rebalance
+cannot be used; insertion and deletion instead rebalance on the way
+back up the copied path, after Okasaki (insertion) and Kahrs
+(deletion).  The color representation is the one used by rb_tree.
+
+Iterators are forward iterators that hold the path from the root.
+They do not hold references; an iterator remains valid as long as
+some persistent_map holding the version it came from is alive.
+
+Reference counts are maintained with the same thread primitives as
+rope, so in a multithreaded build a version may be handed to another
+thread and read there without further locking.
+
+*/
+
+#ifdef __STL_SGI_THREADS
+#  include <mutex.h>
+#endif
+
+__STL_BEGIN_NAMESPACE
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma set woff 1174
+#endif
+
+struct __pmap_refcount
+{
+#   if defined(__STL_WIN32THREADS)
+      long refcount;            // InterlockedIncrement wants a long *
+#   else
+      size_t refcount;
+#   endif
+#   ifdef __STL_SGI_THREADS
+#     if __mips < 3 || !(defined (_ABIN32) || defined(_ABI64))
+#       define __add_and_fetch(l,v) add_then_test((unsigned long *)l,v)
+#     endif
+      void init_refcount_lock() {}
+      void incr_refcount() { __add_and_fetch(&refcount, 1); }
+      size_t decr_refcount() {
+        return __add_and_fetch(&refcount, (size_t)(-1));
+      }
+#   elif defined(__STL_WIN32THREADS)
+      void init_refcount_lock() {}
+      void incr_refcount() { InterlockedIncrement(&refcount); }
+      size_t decr_refcount() { return InterlockedDecrement(&refcount); }
+#   elif defined(__STL_PTHREADS)
+      pthread_mutex_t refcount_lock;
+      void init_refcount_lock() { pthread_mutex_init(&refcount_lock, 0); }
+      void incr_refcount() {
+        pthread_mutex_lock(&refcount_lock);
+        ++refcount;
+        pthread_mutex_unlock(&refcount_lock);
+      }
+      size_t decr_refcount() {
+        size_t result;
+        pthread_mutex_lock(&refcount_lock);
+        result = --refcount;
+        pthread_mutex_unlock(&refcount_lock);
+        return result;
+      }
+#   else
+      void init_refcount_lock() {}
+      void incr_refcount() { ++refcount; }
+      size_t decr_refcount() { return --refcount; }
+#   endif
+};
+
+template <class Value>
+struct __pmap_node : public __pmap_refcount
+{
+  typedef __rb_tree_color_type color_type;
+  typedef __pmap_node<Value>* link_type;
+
+  color_type color;
+  link_type left;
+  link_type right;
+  Value value_field;
+};
+
+// Upper bound on the height of a red-black tree whose size fits in a
+// size_t: 2 * log2(n + 1).
+enum { __pmap_max_depth = 2 * 8 * sizeof(size_t) };
+
+template <class Value>
+struct __pmap_iterator
+{
+  typedef Value value_type;
+  typedef const Value& reference;
+  typedef const Value* pointer;
+  typedef forward_iterator_tag iterator_category;
+  typedef ptrdiff_t difference_type;
+  typedef __pmap_iterator<Value> self;
+  typedef __pmap_node<Value>* link_type;
+
+  // stack[0 .. depth) are the nodes still to be visited whose left
+  // subtree contains the current position; stack[depth - 1] is current.
+  link_type stack[__pmap_max_depth];
+  int depth;
+
+  __pmap_iterator() : depth(0) {}
+  __pmap_iterator(const self& x) : depth(x.depth) {
+    for (int i = 0; i < depth; ++i)
+      stack[i] = x.stack[i];
+  }
+  self& operator=(const self& x) {
+    depth = x.depth;
+    for (int i = 0; i < depth; ++i)
+      stack[i] = x.stack[i];
+    return *this;
+  }
+
+  link_type node() const { return depth == 0 ? 0 : stack[depth - 1]; }
+
+  void push_leftmost(link_type x) {
+    for ( ; x != 0; x = x->left)
+      stack[depth++] = x;
+  }
+
+  reference operator*() const { return node()->value_field; }
+#ifndef __SGI_STL_NO_ARROW_OPERATOR
+  pointer operator->() const { return &(operator*()); }
+#endif /* __SGI_STL_NO_ARROW_OPERATOR */
+
+  self& operator++() {
+    link_type x = stack[--depth];
+    push_leftmost(x->right);
+    return *this;
+  }
+  self operator++(int) {
+    self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  bool operator==(const self& x) const { return node() == x.node(); }
+  bool operator!=(const self& x) const { return node() != x.node(); }
+};
+
+#ifndef __STL_CLASS_PARTIAL_SPECIALIZATION
+
+template <class Value>
+inline forward_iterator_tag
+iterator_category(const __pmap_iterator<Value>&) {
+  return forward_iterator_tag();
+}
+
+template <class Value>
+inline ptrdiff_t*
+distance_type(const __pmap_iterator<Value>&) {
+  return (ptrdiff_t*) 0;
+}
+
+template <class Value>
+inline Value* value_type(const __pmap_iterator<Value>&) {
+  return (Value*) 0;
+}
+
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
+#ifndef __STL_LIMITED_DEFAULT_TEMPLATES
+template <class Key, class T, class Compare = less<Key>, class Alloc = alloc>
+#else
+template <class Key, class T, class Compare, class Alloc = alloc>
+#endif
+class persistent_map {
+public:
+
+// typedefs:
+
+  typedef Key key_type;
+  typedef T data_type;
+  typedef T mapped_type;
+  typedef pair<const Key, T> value_type;
+  typedef Compare key_compare;
+
+  class value_compare
+    : public binary_function<value_type, value_type, bool> {
+  friend class persistent_map<Key, T, Compare, Alloc>;
+  protected :
+    Compare comp;
+    value_compare(Compare c) : comp(c) {}
+  public:
+    bool operator()(const value_type& x, const value_type& y) const {
+      return comp(x.first, y.first);
+    }
+  };
+
+  typedef const value_type* pointer;
+  typedef const value_type* const_pointer;
+  typedef const value_type& reference;
+  typedef const value_type& const_reference;
+  typedef __pmap_iterator<value_type> const_iterator;
+  typedef const_iterator iterator;      // elements are never mutable
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+protected:
+  typedef __pmap_node<value_type> node_type;
+  typedef node_type* link_type;
+  typedef simple_alloc<node_type, Alloc> node_allocator;
+  typedef __rb_tree_color_type color_type;
+
+  link_type root;
+  size_type node_count;
+  Compare comp;
+
+  static const Key& key(link_type x) { return x->value_field.first; }
+  static bool is_red(link_type x) {
+    return x != 0 && x->color == __rb_tree_red;
+  }
+  static bool is_black(link_type x) {
+    return x != 0 && x->color == __rb_tree_black;
+  }
+
+  // Reference counting.  Functions below document whether a link_type
+  // argument is borrowed or owned (consumed); results are always owned.
+  static link_type ref(link_type x) {
+    if (x != 0) x->incr_refcount();
+    return x;
+  }
+  static void unref(link_type x) {
+    if (x != 0 && x->decr_refcount() == 0) {
+      unref(x->left);
+      unref(x->right);
+      destroy(&x->value_field);
+      node_allocator::deallocate(x);
+    }
+  }
+
+  // Consumes l and r, also if an exception is thrown.
+  static link_type create_node(color_type c, link_type l,
+                               const value_type& v, link_type r) {
+    link_type tmp = node_allocator::allocate();
+    __STL_TRY {
+      construct(&tmp->value_field, v);
+    }
+    __STL_UNWIND((node_allocator::deallocate(tmp), unref(l), unref(r)));
+    tmp->refcount = 1;
+    tmp->init_refcount_lock();
+    tmp->color = c;
+    tmp->left = l;
+    tmp->right = r;
+    return tmp;
+  }
+
+  // The node x (owned) with its color changed; x is reused if unshared.
+  // Consumes x, also if an exception is thrown.
+  static link_type recolor(link_type x, color_type c) {
+    if (x->refcount == 1) {
+      x->color = c;
+      return x;
+    }
+    link_type tmp;
+    __STL_TRY {
+      tmp = create_node(c, ref(x->left), x->value_field, ref(x->right));
+    }
+    __STL_UNWIND(unref(x));
+    unref(x);
+    return tmp;
+  }
+
+  // T R (T B a x b) y (T B c z d).  Consumes a, b, c, d; the values
+  // are borrowed from nodes the caller still owns.
+  static link_type make_rbb(link_type a, const value_type& x, link_type b,
+                            const value_type& y,
+                            link_type c, const value_type& z, link_type d) {
+    link_type l;
+    __STL_TRY {
+      l = create_node(__rb_tree_black, a, x, b);
+    }
+    __STL_UNWIND((unref(c), unref(d)));
+    link_type r;
+    __STL_TRY {
+      r = create_node(__rb_tree_black, c, z, d);
+    }
+    __STL_UNWIND(unref(l));
+    return create_node(__rb_tree_red, l, y, r);
+  }
+
+  static link_type balance(link_type l, const value_type& v, link_type r);
+  static link_type balance_left(link_type l, const value_type& v,
+                                link_type r);
+  static link_type balance_right(link_type l, const value_type& v,
+                                 link_type r);
+  static link_type append(link_type l, link_type r);
+  link_type ins(link_type x, const value_type& v);
+  link_type del(link_type x, const key_type& k);
+
+public:
+                                // allocation/deallocation
+
+  persistent_map() : root(0), node_count(0), comp(Compare()) {}
+  explicit persistent_map(const Compare& c)
+    : root(0), node_count(0), comp(c) {}
+
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class InputIterator>
+  persistent_map(InputIterator first, InputIterator last)
+    : root(0), node_count(0), comp(Compare()) { insert(first, last); }
+
+  template <class InputIterator>
+  persistent_map(InputIterator first, InputIterator last, const Compare& c)
+    : root(0), node_count(0), comp(c) { insert(first, last); }
+#else
+  persistent_map(const value_type* first, const value_type* last)
+    : root(0), node_count(0), comp(Compare()) { insert(first, last); }
+  persistent_map(const value_type* first, const value_type* last,
+                 const Compare& c)
+    : root(0), node_count(0), comp(c) { insert(first, last); }
+#endif /* __STL_MEMBER_TEMPLATES */
+
+  // Copying takes a snapshot: O(1), the nodes are shared.
+  persistent_map(const persistent_map<Key, T, Compare, Alloc>& x)
+    : root(ref(x.root)), node_count(x.node_count), comp(x.comp) {}
+  persistent_map<Key, T, Compare, Alloc>&
+  operator=(const persistent_map<Key, T, Compare, Alloc>& x) {
+    link_type old = root;
+    root = ref(x.root);
+    node_count = x.node_count;
+    comp = x.comp;
+    unref(old);
+    return *this;
+  }
+  ~persistent_map() { unref(root); }
+
+  persistent_map<Key, T, Compare, Alloc> snapshot() const { return *this; }
+
+                                // accessors:
+
+  key_compare key_comp() const { return comp; }
+  value_compare value_comp() const { return value_compare(comp); }
+  const_iterator begin() const {
+    const_iterator it;
+    it.push_leftmost(root);
+    return it;
+  }
+  const_iterator end() const { return const_iterator(); }
+  bool empty() const { return node_count == 0; }
+  size_type size() const { return node_count; }
+  size_type max_size() const { return size_type(-1); }
+  void swap(persistent_map<Key, T, Compare, Alloc>& x) {
+    __STD::swap(root, x.root);
+    __STD::swap(node_count, x.node_count);
+    __STD::swap(comp, x.comp);
+  }
+
+                                // insert/erase
+
+  // Returns false, leaving the map unchanged, if the key is present.
+  bool insert(const value_type& x);
+  // Inserts x, or replaces the element with an equivalent key.
+  void insert_or_assign(const value_type& x);
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    for ( ; first != last; ++first)
+      insert(*first);
+  }
+#else
+  void insert(const value_type* first, const value_type* last) {
+    for ( ; first != last; ++first)
+      insert(*first);
+  }
+  void insert(const_iterator first, const_iterator last) {
+    for ( ; first != last; ++first)
+      insert(*first);
+  }
+#endif /* __STL_MEMBER_TEMPLATES */
+
+  size_type erase(const key_type& x);
+  void clear() {
+    unref(root);
+    root = 0;
+    node_count = 0;
+  }
+
+                                // map operations:
+
+  const_iterator find(const key_type& x) const {
+    const_iterator j = lower_bound(x);
+    return (j == end() || comp(x, key(j.node()))) ? end() : j;
+  }
+  size_type count(const key_type& x) const { return find(x) == end() ? 0 : 1; }
+  const_iterator lower_bound(const key_type& x) const {
+    const_iterator it;
+    for (link_type y = root; y != 0; )
+      if (!comp(key(y), x))
+        it.stack[it.depth++] = y, y = y->left;
+      else
+        y = y->right;
+    return it;
+  }
+  const_iterator upper_bound(const key_type& x) const {
+    const_iterator it;
+    for (link_type y = root; y != 0; )
+      if (comp(x, key(y)))
+        it.stack[it.depth++] = y, y = y->left;
+      else
+        y = y->right;
+    return it;
+  }
+  pair<const_iterator,const_iterator> equal_range(const key_type& x) const {
+    return pair<const_iterator,const_iterator>(lower_bound(x), upper_bound(x));
+  }
+  // Pointer to the mapped value for x, or 0.
+  const T* lookup(const key_type& x) const {
+    link_type y = root;
+    while (y != 0)
+      if (comp(x, key(y)))
+        y = y->left;
+      else if (comp(key(y), x))
+        y = y->right;
+      else
+        return &y->value_field.second;
+    return 0;
+  }
+
+                                // Debugging.
+  bool __rb_verify() const;
+};
+
+template <class Key, class T, class Compare, class Alloc>
+inline bool operator==(const persistent_map<Key, T, Compare, Alloc>& x,
+                       const persistent_map<Key, T, Compare, Alloc>& y) {
+  return x.size() == y.size() && equal(x.begin(), x.end(), y.begin());
+}
+
+template <class Key, class T, class Compare, class Alloc>
+inline bool operator<(const persistent_map<Key, T, Compare, Alloc>& x,
+                      const persistent_map<Key, T, Compare, Alloc>& y) {
+  return lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+#ifdef __STL_FUNCTION_TMPL_PARTIAL_ORDER
+
+template <class Key, class T, class Compare, class Alloc>
+inline void swap(persistent_map<Key, T, Compare, Alloc>& x,
+                 persistent_map<Key, T, Compare, Alloc>& y) {
+  x.swap(y);
+}
+
+#endif /* __STL_FUNCTION_TMPL_PARTIAL_ORDER */
+
+// Black node over l and r (both owned), resolving a red-red violation
+// on either side.
+template <class Key, class T, class Compare, class Alloc>
+typename persistent_map<Key, T, Compare, Alloc>::link_type
+persistent_map<Key, T, Compare, Alloc>::balance(link_type l,
+                                                const value_type& v,
+                                                link_type r) {
+  link_type result;
+  if (is_red(l) && is_red(r)) {
+    link_type nl, nr;
+    __STL_TRY {
+      nl = recolor(l, __rb_tree_black);
+    }
+    __STL_UNWIND(unref(r));
+    __STL_TRY {
+      nr = recolor(r, __rb_tree_black);
+    }
+    __STL_UNWIND(unref(nl));
+    return create_node(__rb_tree_red, nl, v, nr);
+  }
+  else if (is_red(l) && (is_red(l->left) || is_red(l->right))) {
+    __STL_TRY {
+      if (is_red(l->left))
+        result = make_rbb(ref(l->left->left), l->left->value_field,
+                          ref(l->left->right), l->value_field,
+                          ref(l->right), v, r);
+      else
+        result = make_rbb(ref(l->left), l->value_field,
+                          ref(l->right->left), l->right->value_field,
+                          ref(l->right->right), v, r);
+    }
+    __STL_UNWIND(unref(l));
+    unref(l);
+  }
+  else if (is_red(r) && (is_red(r->left) || is_red(r->right))) {
+    __STL_TRY {
+      if (is_red(r->left))
+        result = make_rbb(l, v, ref(r->left->left), r->left->value_field,
+                          ref(r->left->right), r->value_field,
+                          ref(r->right));
+      else
+        result = make_rbb(l, v, ref(r->left), r->value_field,
+                          ref(r->right->left), r->right->value_field,
+                          ref(r->right->right));
+    }
+    __STL_UNWIND(unref(r));
+    unref(r);
+  }
+  else
+    result = create_node(__rb_tree_black, l, v, r);
+  return result;
+}
+
+// l has a black height one less than r.
+template <class Key, class T, class Compare, class Alloc>
+typename persistent_map<Key, T, Compare, Alloc>::link_type
+persistent_map<Key, T, Compare, Alloc>::balance_left(link_type l,
+                                                     const value_type& v,
+                                                     link_type r) {
+  if (is_red(l)) {
+    link_type nl;
+    __STL_TRY {
+      nl = recolor(l, __rb_tree_black);
+    }
+    __STL_UNWIND(unref(r));
+    return create_node(__rb_tree_red, nl, v, r);
+  }
+  if (is_black(r)) {
+    link_type nr;
+    __STL_TRY {
+      nr = recolor(r, __rb_tree_red);
+    }
+    __STL_UNWIND(unref(l));
+    return balance(l, v, nr);
+  }
+  // r is red with a black left child.
+  link_type rl = r->left;
+  link_type nl, nr;
+  __STL_TRY {
+    nl = create_node(__rb_tree_black, l, v, ref(rl->left));
+  }
+  __STL_UNWIND(unref(r));
+  __STL_TRY {
+    link_type c = recolor(ref(r->right), __rb_tree_red);
+    nr = balance(ref(rl->right), r->value_field, c);
+  }
+  __STL_UNWIND((unref(nl), unref(r)));
+  link_type result;
+  __STL_TRY {
+    result = create_node(__rb_tree_red, nl, rl->value_field, nr);
+  }
+  __STL_UNWIND(unref(r));
+  unref(r);
+  return result;
+}
+
+// r has a black height one less than l.
+template <class Key, class T, class Compare, class Alloc>
+typename persistent_map<Key, T, Compare, Alloc>::link_type
+persistent_map<Key, T, Compare, Alloc>::balance_right(link_type l,
+                                                      const value_type& v,
+                                                      link_type r) {
+  if (is_red(r)) {
+    link_type nr;
+    __STL_TRY {
+      nr = recolor(r, __rb_tree_black);
+    }
+    __STL_UNWIND(unref(l));
+    return create_node(__rb_tree_red, l, v, nr);
+  }
+  if (is_black(l)) {
+    link_type nl;
+    __STL_TRY {
+      nl = recolor(l, __rb_tree_red);
+    }
+    __STL_UNWIND(unref(r));
+    return balance(nl, v, r);
+  }
+  // l is red with a black right child.
+  link_type lr = l->right;
+  link_type nl, nr;
+  __STL_TRY {
+    nr = create_node(__rb_tree_black, ref(lr->right), v, r);
+  }
+  __STL_UNWIND(unref(l));
+  __STL_TRY {
+    link_type a = recolor(ref(l->left), __rb_tree_red);
+    nl = balance(a, l->value_field, ref(lr->left));
+  }
+  __STL_UNWIND((unref(nr), unref(l)));
+  link_type result;
+  __STL_TRY {
+    result = create_node(__rb_tree_red, nl, lr->value_field, nr);
+  }
+  __STL_UNWIND(unref(l));
+  unref(l);
+  return result;
+}
+
+// Joins l and r (both owned), every key of l being less than every key
+// of r and both having the same black height.
+template <class Key, class T, class Compare, class Alloc>
+typename persistent_map<Key, T, Compare, Alloc>::link_type
+persistent_map<Key, T, Compare, Alloc>::append(link_type l, link_type r) {
+  if (l == 0) return r;
+  if (r == 0) return l;
+  link_type result;
+  if (l->color == r->color) {
+    link_type m;
+    __STL_TRY {
+      m = append(ref(l->right), ref(r->left));
+    }
+    __STL_UNWIND((unref(l), unref(r)));
+    __STL_TRY {
+      if (is_red(m)) {
+        color_type c = l->color;
+        link_type ml = ref(m->left), mr = ref(m->right);
+        link_type nl, nr;
+        __STL_TRY {
+          nl = create_node(c, ref(l->left), l->value_field, ml);
+        }
+        __STL_UNWIND((unref(m), unref(mr)));
+        __STL_TRY {
+          nr = create_node(c, mr, r->value_field, ref(r->right));
+        }
+        __STL_UNWIND((unref(m), unref(nl)));
+        __STL_TRY {
+          result = create_node(__rb_tree_red, nl, m->value_field, nr);
+        }
+        __STL_UNWIND(unref(m));
+        unref(m);
+      }
+      else {
+        link_type nr = create_node(r->color, m, r->value_field,
+                                   ref(r->right));
+        if (l->color == __rb_tree_red)
+          result = create_node(__rb_tree_red, ref(l->left), l->value_field,
+                               nr);
+        else
+          result = balance_left(ref(l->left), l->value_field, nr);
+      }
+    }
+    __STL_UNWIND((unref(l), unref(r)));
+  }
+  else if (is_red(r)) {
+    link_type m;
+    __STL_TRY {
+      m = append(l, ref(r->left));
+    }
+    __STL_UNWIND(unref(r));
+    __STL_TRY {
+      result = create_node(__rb_tree_red, m, r->value_field, ref(r->right));
+    }
+    __STL_UNWIND(unref(r));
+    unref(r);
+    return result;
+  }
+  else {
+    link_type m;
+    __STL_TRY {
+      m = append(ref(l->right), r);
+    }
+    __STL_UNWIND(unref(l));
+    __STL_TRY {
+      result = create_node(__rb_tree_red, ref(l->left), l->value_field, m);
+    }
+    __STL_UNWIND(unref(l));
+    unref(l);
+    return result;
+  }
+  unref(l);
+  unref(r);
+  return result;
+}
+
+// x is borrowed.  An element with the key of v is replaced by v.
+template <class Key, class T, class Compare, class Alloc>
+typename persistent_map<Key, T, Compare, Alloc>::link_type
+persistent_map<Key, T, Compare, Alloc>::ins(link_type x, const value_type& v) {
+  if (x == 0)
+    return create_node(__rb_tree_red, 0, v, 0);
+  if (comp(v.first, key(x))) {
+    link_type l = ins(x->left, v);
+    if (x->color == __rb_tree_black)
+      return balance(l, x->value_field, ref(x->right));
+    return create_node(__rb_tree_red, l, x->value_field, ref(x->right));
+  }
+  else if (comp(key(x), v.first)) {
+    link_type r = ins(x->right, v);
+    if (x->color == __rb_tree_black)
+      return balance(ref(x->left), x->value_field, r);
+    return create_node(__rb_tree_red, ref(x->left), x->value_field, r);
+  }
+  else
+    return create_node(x->color, ref(x->left), v, ref(x->right));
+}
+
+// x is borrowed and not null.  The key k is known to be present.
+template <class Key, class T, class Compare, class Alloc>
+typename persistent_map<Key, T, Compare, Alloc>::link_type
+persistent_map<Key, T, Compare, Alloc>::del(link_type x, const key_type& k) {
+  if (comp(k, key(x))) {
+    link_type l = del(x->left, k);
+    if (is_black(x->left))
+      return balance_left(l, x->value_field, ref(x->right));
+    return create_node(__rb_tree_red, l, x->value_field, ref(x->right));
+  }
+  else if (comp(key(x), k)) {
+    link_type r = del(x->right, k);
+    if (is_black(x->right))
+      return balance_right(ref(x->left), x->value_field, r);
+    return create_node(__rb_tree_red, ref(x->left), x->value_field, r);
+  }
+  else
+    return append(ref(x->left), ref(x->right));
+}
+
+template <class Key, class T, class Compare, class Alloc>
+bool persistent_map<Key, T, Compare, Alloc>::insert(const value_type& v) {
+  if (lookup(v.first) != 0)
+    return false;
+  link_type x = ins(root, v);
+  x = recolor(x, __rb_tree_black);
+  unref(root);
+  root = x;
+  ++node_count;
+  return true;
+}
+
+template <class Key, class T, class Compare, class Alloc>
+void
+persistent_map<Key, T, Compare, Alloc>::insert_or_assign(const value_type& v) {
+  bool present = lookup(v.first) != 0;
+  link_type x = ins(root, v);
+  x = recolor(x, __rb_tree_black);
+  unref(root);
+  root = x;
+  if (!present)
+    ++node_count;
+}
+
+template <class Key, class T, class Compare, class Alloc>
+typename persistent_map<Key, T, Compare, Alloc>::size_type
+persistent_map<Key, T, Compare, Alloc>::erase(const key_type& k) {
+  if (lookup(k) == 0)
+    return 0;
+  link_type x = del(root, k);
+  if (x != 0)
+    x = recolor(x, __rb_tree_black);
+  unref(root);
+  root = x;
+  --node_count;
+  return 1;
+}
+
+template <class Value>
+inline int __pmap_black_height(__pmap_node<Value>* x)
+{
+  if (x == 0)
+    return 1;
+  int l = __pmap_black_height(x->left);
+  int r = __pmap_black_height(x->right);
+  if (l == 0 || l != r)
+    return 0;
+  if (x->color == __rb_tree_red &&
+      ((x->left && x->left->color == __rb_tree_red) ||
+       (x->right && x->right->color == __rb_tree_red)))
+    return 0;
+  return l + (x->color == __rb_tree_black ? 1 : 0);
+}
+
+template <class Key, class T, class Compare, class Alloc>
+bool persistent_map<Key, T, Compare, Alloc>::__rb_verify() const
+{
+  if (root == 0)
+    return node_count == 0;
+  if (root->color != __rb_tree_black || __pmap_black_height(root) == 0)
+    return false;
+  size_type n = 0;
+  const_iterator prev = end();
+  for (const_iterator it = begin(); it != end(); ++it, ++n) {
+    if (prev != end() && !comp(prev->first, it->first))
+      return false;
+    prev = it;
+  }
+  return n == node_count;
+}
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma reset woff 1174
+#endif
+
+__STL_END_NAMESPACE
+
+#endif /* __SGI_STL_INTERNAL_PERSISTENT_MAP_H */
+
+// Local Variables:
+// mode:C++
+// End:
@@ -57,6 +57,25 @@ public:
   const_reference back() const { return c.back(); }
   void push(const value_type& x) { c.push_back(x); }
   void pop() { c.pop_front(); }
+
+  // Push the n values starting at first; pop the first n values, which
+  // must not be more than size(), into result.  These need a Sequence
+  // with push_back_n and pop_front_n, such as deque.
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class InputIterator>
+  void push_n(InputIterator first, size_type n) { c.push_back_n(first, n); }
+  template <class OutputIterator>
+  OutputIterator pop_n(OutputIterator result, size_type n) {
+    return c.pop_front_n(result, n);
+  }
+#else /* __STL_MEMBER_TEMPLATES */
+  void push_n(const value_type* first, size_type n) {
+    c.push_back_n(first, n);
+  }
+  value_type* pop_n(value_type* result, size_type n) {
+    return c.pop_front_n(result, n);
+  }
+#endif /* __STL_MEMBER_TEMPLATES */
 };
 
 template <class T, class Sequence>
@@ -69,11 +88,15 @@ bool operator<(const queue<T, Sequence>& x, const queue<T, Sequence>& y) {
   return x.c < y.c;
 }
 
+// Arity is the number of children of each node of the heap kept in c;
+// see the d-ary heap functions in stl_heap.h.  4 or 8 make push and pop
+// touch fewer cache lines on large queues of small elements.
 #ifndef __STL_LIMITED_DEFAULT_TEMPLATES
 template <class T, class Sequence = vector<T>, 
-          class Compare = less<typename Sequence::value_type> >
+          class Compare = less<typename Sequence::value_type>,
+          size_t Arity = 2>
 #else
-template <class T, class Sequence, class Compare>
+template <class T, class Sequence, class Compare, size_t Arity = 2>
 #endif
 class  priority_queue {
 public:
@@ -91,17 +114,19 @@ public:
 #ifdef __STL_MEMBER_TEMPLATES
   template <class InputIterator>
   priority_queue(InputIterator first, InputIterator last, const Compare& x)
-    : c(first, last), comp(x) { make_heap(c.begin(), c.end(), comp); }
+    : c(first, last), comp(x) {
+    make_dary_heap<Arity>(c.begin(), c.end(), comp);
+  }
   template <class InputIterator>
   priority_queue(InputIterator first, InputIterator last) 
-    : c(first, last) { make_heap(c.begin(), c.end(), comp); }
+    : c(first, last) { make_dary_heap<Arity>(c.begin(), c.end(), comp); }
 #else /* __STL_MEMBER_TEMPLATES */
   priority_queue(const value_type* first, const value_type* last, 
                  const Compare& x) : c(first, last), comp(x) {
-    make_heap(c.begin(), c.end(), comp);
+    make_dary_heap<Arity>(c.begin(), c.end(), comp);
   }
   priority_queue(const value_type* first, const value_type* last) 
-    : c(first, last) { make_heap(c.begin(), c.end(), comp); }
+    : c(first, last) { make_dary_heap<Arity>(c.begin(), c.end(), comp); }
 #endif /* __STL_MEMBER_TEMPLATES */
 
   bool empty() const { return c.empty(); }
@@ -110,13 +135,13 @@ public:
   void push(const value_type& x) {
     __STL_TRY {
       c.push_back(x); 
-      push_heap(c.begin(), c.end(), comp);
+      push_dary_heap<Arity>(c.begin(), c.end(), comp);
     }
     __STL_UNWIND(c.clear());
   }
   void pop() {
     __STL_TRY {
-      pop_heap(c.begin(), c.end(), comp);
+      pop_dary_heap<Arity>(c.begin(), c.end(), comp);
       c.pop_back();
     }
     __STL_UNWIND(c.clear());
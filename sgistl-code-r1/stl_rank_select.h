@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 1997
+ * Silicon Graphics Computer Systems, Inc.
+ *
+ * Permission to use, copy, modify, distribute and sell this software
+ * and its documentation for any purpose is hereby granted without fee,
+ * provided that the above copyright notice appear in all copies and
+ * that both that copyright notice and this permission notice appear
+ * in supporting documentation.  Silicon Graphics makes no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ */
+
+/* NOTE: This is an internal header file, included by other STL headers.
+ *   You should not attempt to use it directly.
+ */
+
+#ifndef __SGI_STL_INTERNAL_RANK_SELECT_H
+#define __SGI_STL_INTERNAL_RANK_SELECT_H
+
+/*
+
+Rank/select index over the bits of a bit_vector.
+
+rank1(i) is the number of set bits in [0, i), and select1(k) is the
+position of the set bit whose rank is k, i.e. of the (k+1)-th one.
+
+The index is built once from a range of bit iterators.  It keeps a
+pointer to the vector's words rather than a copy of them, so it is
+invalidated by anything that modifies or reallocates the vector.
+
+The bits are split into blocks of block_bits bits, and the blocks into
+superblocks of blocks_per_super blocks.  Each superblock stores the
+number of ones before it; each block stores, in an unsigned short, the
+number of ones between the start of its superblock and the block.
+rank1 is two table lookups plus the popcount of at most one block's
+words, and the tables add a little over 3% to the size of the bits.
+
+select1 also stores, for every select_sample-th one, the block that
+holds it.  Two consecutive samples bound a binary search over the block
+counts; the answer is then found among that block's words, and within
+its word one byte at a time.
+
+*/
+
+__STL_BEGIN_NAMESPACE
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma set woff 1174
+#endif
+
+// Position of the set bit of x whose rank within x is k; x must have
+// more than k bits set.
+inline unsigned int __bit_select(__bit_word x, unsigned int k) {
+  unsigned int base = 0;
+  for (;;) {
+    unsigned int c = __bit_popcount(x & 0xff);
+    if (k < c)
+      break;
+    k -= c;
+    x >>= 8;
+    base += 8;
+  }
+  for ( ; k != 0; --k)
+    x &= x - 1;
+  return base + __bit_lowest(x);
+}
+
+template <class Alloc = alloc>
+class bit_rank_select {
+public:
+  typedef size_t size_type;
+
+protected:
+  enum { block_bits = 512,
+         blocks_per_super = 128,
+         select_sample = 8192 };
+
+  typedef simple_alloc<size_type, Alloc> size_allocator;
+  typedef simple_alloc<unsigned short, Alloc> block_allocator;
+
+  const __bit_word* words;
+  size_type nbits;
+  size_type ones;
+  size_type* supers;            // ones before each superblock
+  unsigned short* blocks;       // ones from its superblock to each block
+  size_type* samples;           // block holding each select_sample-th one
+
+  static size_type words_per_block() { return block_bits / __WORD_BIT; }
+  size_type block_count() const { return nbits / block_bits + 1; }
+  size_type super_count() const {
+    return (block_count() - 1) / blocks_per_super + 1;
+  }
+  size_type sample_count() const { return ones / select_sample + 1; }
+
+  // Ones before block b.
+  size_type block_rank(size_type b) const {
+    return supers[b / blocks_per_super] + blocks[b];
+  }
+
+  void allocate_tables() {
+    supers = size_allocator::allocate(super_count());
+    __STL_TRY {
+      blocks = block_allocator::allocate(block_count());
+    }
+    __STL_UNWIND(size_allocator::deallocate(supers, super_count()));
+  }
+  void deallocate_tables() {
+    if (supers) {
+      size_allocator::deallocate(supers, super_count());
+      block_allocator::deallocate(blocks, block_count());
+      size_allocator::deallocate(samples, sample_count());
+    }
+  }
+
+  void initialize(__bit_const_iterator first, __bit_const_iterator last);
+
+public:
+  bit_rank_select()
+    : words(0), nbits(0), ones(0), supers(0), blocks(0), samples(0) {}
+
+  // first must be the beginning of a vector, or at least of a word.
+  bit_rank_select(__bit_const_iterator first, __bit_const_iterator last) {
+    initialize(first, last);
+  }
+
+  bit_rank_select(const bit_rank_select<Alloc>& x)
+    : words(x.words), nbits(x.nbits), ones(x.ones),
+      supers(0), blocks(0), samples(0) {
+    if (x.supers) {
+      allocate_tables();
+      __STL_TRY {
+        samples = size_allocator::allocate(sample_count());
+      }
+      __STL_UNWIND((size_allocator::deallocate(supers, super_count()),
+                    block_allocator::deallocate(blocks, block_count())));
+      copy(x.supers, x.supers + super_count(), supers);
+      copy(x.blocks, x.blocks + block_count(), blocks);
+      copy(x.samples, x.samples + sample_count(), samples);
+    }
+  }
+  bit_rank_select<Alloc>& operator=(const bit_rank_select<Alloc>& x) {
+    if (this != &x) {
+      bit_rank_select<Alloc> tmp(x);
+      swap(tmp);
+    }
+    return *this;
+  }
+  ~bit_rank_select() { deallocate_tables(); }
+
+  size_type size() const { return nbits; }
+  size_type count() const { return ones; }
+  void swap(bit_rank_select<Alloc>& x) {
+    __STD::swap(words, x.words);
+    __STD::swap(nbits, x.nbits);
+    __STD::swap(ones, x.ones);
+    __STD::swap(supers, x.supers);
+    __STD::swap(blocks, x.blocks);
+    __STD::swap(samples, x.samples);
+  }
+
+  // Number of set bits in [0, i); requires i <= size().
+  size_type rank1(size_type i) const {
+    if (nbits == 0)
+      return 0;
+    const size_type b = i / block_bits;
+    size_type r = block_rank(b);
+    const __bit_word* p = words + b * words_per_block();
+    const __bit_word* q = words + i / __WORD_BIT;
+    for ( ; p != q; ++p)
+      r += __bit_popcount(*p);
+    if (i % __WORD_BIT != 0)
+      r += __bit_popcount(*q & __bit_mask(i % __WORD_BIT));
+    return r;
+  }
+  size_type rank0(size_type i) const { return i - rank1(i); }
+
+  // Position of the set bit of rank k; requires k < count().
+  size_type select1(size_type k) const {
+    const size_type j = k / select_sample;
+    size_type lo = samples[j];
+    size_type hi = j + 1 < sample_count() ? samples[j + 1]
+                                          : block_count() - 1;
+                                // find the last block in [lo, hi]
+                                // with at most k ones before it
+    while (lo < hi) {
+      size_type mid = lo + (hi - lo + 1) / 2;
+      if (block_rank(mid) <= k)
+        lo = mid;
+      else
+        hi = mid - 1;
+    }
+    k -= block_rank(lo);
+    const __bit_word* p = words + lo * words_per_block();
+    for (;;) {
+      size_type c = __bit_popcount(*p);
+      if (k < c)
+        break;
+      k -= c;
+      ++p;
+    }
+    return size_type(p - words) * __WORD_BIT
+           + __bit_select(*p, (unsigned int) k);
+  }
+};
+
+template <class Alloc>
+void bit_rank_select<Alloc>::initialize(__bit_const_iterator first,
+                                        __bit_const_iterator last)
+{
+  __stl_assert(first.offset == 0);
+  words = first.p;
+  nbits = last - first;
+  ones = 0;
+  if (nbits == 0) {
+    supers = samples = 0;
+    blocks = 0;
+    return;
+  }
+  allocate_tables();
+
+  const size_type nblocks = block_count();
+  const size_type full_words = nbits / __WORD_BIT;
+  const __bit_word* p = words;
+  for (size_type b = 0; b < nblocks; ++b) {
+    if (b % blocks_per_super == 0)
+      supers[b / blocks_per_super] = ones;
+    blocks[b] = (unsigned short) (ones - supers[b / blocks_per_super]);
+    const __bit_word* q =
+      words + min(full_words, (b + 1) * words_per_block());
+    for ( ; p != q; ++p)
+      ones += __bit_popcount(*p);
+  }
+  if (nbits % __WORD_BIT != 0)
+    ones += __bit_popcount(*p & __bit_mask(nbits % __WORD_BIT));
+
+  __STL_TRY {
+    samples = size_allocator::allocate(sample_count());
+  }
+  __STL_UNWIND((size_allocator::deallocate(supers, super_count()),
+                block_allocator::deallocate(blocks, block_count())));
+  size_type s = 0;
+  for (size_type b = 0; b < nblocks; ++b) {
+    const size_type next = b + 1 < nblocks ? block_rank(b + 1) : ones;
+    for ( ; s < sample_count() && s * select_sample < next; ++s)
+      samples[s] = b;
+  }
+  for ( ; s < sample_count(); ++s)
+    samples[s] = nblocks - 1;
+}
+
+#ifdef __STL_FUNCTION_TMPL_PARTIAL_ORDER
+
+template <class Alloc>
+inline void swap(bit_rank_select<Alloc>& x, bit_rank_select<Alloc>& y) {
+  x.swap(y);
+}
+
+#endif /* __STL_FUNCTION_TMPL_PARTIAL_ORDER */
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma reset woff 1174
+#endif
+
+__STL_END_NAMESPACE
+
+#endif /* __SGI_STL_INTERNAL_RANK_SELECT_H */
+
+// Local Variables:
+// mode:C++
+// End:
@@ -0,0 +1,849 @@
+/*
+ * Copyright (c) 1997
+ * Silicon Graphics Computer Systems, Inc.
+ *
+ * Permission to use, copy, modify, distribute and sell this software
+ * and its documentation for any purpose is hereby granted without fee,
+ * provided that the above copyright notice appear in all copies and
+ * that both that copyright notice and this permission notice appear
+ * in supporting documentation.  Silicon Graphics makes no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ */
+
+/* NOTE: This is an internal header file, included by other STL headers.
+ *   You should not attempt to use it directly.
+ */
+
+#ifndef __SGI_STL_INTERNAL_ROARING_H
+#define __SGI_STL_INTERNAL_ROARING_H
+
+/*
+
+Compressed bitmap for sets of 32-bit unsigned values, in the manner of
+Roaring bitmaps.
+
+The values are split by their high 16 bits into chunks, kept sorted by
+key in a vector.  Each chunk holds the low 16 bits of its values in the
+cheapest of three forms:
+
+  array   a sorted vector of unsigned short, for up to array_max values;
+  bitmap  65536 bits, for denser chunks;
+  run     a sorted vector of [first, last] pairs, for long runs.
+
+Insertion and erasure keep every chunk an array or a bitmap, switching
+between them as the count crosses array_max.  Run chunks are only made
+by optimize(), which converts each chunk to runs when that is smaller;
+modifying a run chunk turns it back into an array or a bitmap.
+
+&=, |= and -= work chunk by chunk.  Array chunks are merged or probed
+value by value; everything else is combined a word at a time, with the
+counts taken by popcount.  Iteration visits the values in increasing
+order.
+
+*/
+
+__STL_BEGIN_NAMESPACE
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma set woff 1174
+#endif
+
+template <class Alloc>
+struct __roaring_chunk {
+  typedef vector<unsigned short, Alloc> value_vector;
+  typedef vector<__bit_word, Alloc> word_vector;
+  typedef size_t size_type;
+
+  enum { array_kind, bitmap_kind, run_kind };
+  enum { array_max = 4096,
+         chunk_bits = 65536,
+         chunk_words = 65536 / __WORD_BIT };
+
+  unsigned short key;
+  unsigned char kind;
+  unsigned int card;
+  value_vector values;          // array values, or run first/last pairs
+  word_vector bits;             // bitmap words
+
+  __roaring_chunk(unsigned short k) : key(k), kind(array_kind), card(0) {}
+
+  void swap(__roaring_chunk<Alloc>& x) {
+    __STD::swap(key, x.key);
+    __STD::swap(kind, x.kind);
+    __STD::swap(card, x.card);
+    values.swap(x.values);
+    bits.swap(x.bits);
+  }
+
+  size_type run_count() const { return values.size() / 2; }
+  bool test(unsigned int v) const {
+    return (bits[v / __WORD_BIT] >> (v % __WORD_BIT)) & 1;
+  }
+  __bit_const_iterator bits_begin() const {
+    return __bit_const_iterator((__bit_word*) &*bits.begin(), 0);
+  }
+  __bit_iterator bits_begin() {
+    return __bit_iterator(&*bits.begin(), 0);
+  }
+
+  // The first set bit at or after from, or chunk_bits if there is none.
+  unsigned int next_bit(unsigned int from) const {
+    if (from >= (unsigned int) chunk_bits)
+      return chunk_bits;
+    size_type w = from / __WORD_BIT;
+    __bit_word x = bits[w] & (~__bit_word(0) << (from % __WORD_BIT));
+    while (x == 0) {
+      if (++w == (size_type) chunk_words)
+        return chunk_bits;
+      x = bits[w];
+    }
+    return (unsigned int) (w * __WORD_BIT + __bit_lowest(x));
+  }
+
+  bool contains(unsigned short v) const;
+  bool insert(unsigned short v);
+  bool erase(unsigned short v);
+
+  void recount() {
+    card = 0;
+    for (size_type i = 0; i < (size_type) chunk_words; ++i)
+      card += __bit_popcount(bits[i]);
+  }
+  void copy_bitmap(word_vector& w) const;
+  void to_bitmap();
+  void to_array();
+  void to_run();
+  void to_plain() {             // array or bitmap, whichever fits card
+    if (card <= (unsigned int) array_max) {
+      if (kind != array_kind)
+        to_array();
+    }
+    else if (kind != bitmap_kind)
+      to_bitmap();
+  }
+  size_type count_runs() const;
+  void optimize() {
+    if (kind == run_kind)
+      return;
+    size_type bytes = kind == array_kind ? card * sizeof(unsigned short)
+                                         : chunk_bits / CHAR_BIT;
+    if (2 * sizeof(unsigned short) * count_runs() < bytes)
+      to_run();
+  }
+
+  void intersect(const __roaring_chunk<Alloc>& x);
+  void unite(const __roaring_chunk<Alloc>& x);
+  void subtract(const __roaring_chunk<Alloc>& x);
+};
+
+template <class Alloc>
+bool __roaring_chunk<Alloc>::contains(unsigned short v) const
+{
+  if (kind == bitmap_kind)
+    return test(v);
+  if (kind == array_kind)
+    return binary_search(values.begin(), values.end(), v);
+  size_type lo = 0;             // find the first run starting after v
+  size_type hi = run_count();
+  while (lo < hi) {
+    size_type mid = lo + (hi - lo) / 2;
+    if (values[2 * mid] <= v)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo != 0 && v <= values[2 * lo - 1];
+}
+
+template <class Alloc>
+bool __roaring_chunk<Alloc>::insert(unsigned short v)
+{
+  if (kind == run_kind)
+    to_plain();
+  if (kind == array_kind) {
+    typename value_vector::iterator i =
+      lower_bound(values.begin(), values.end(), v);
+    if (i != values.end() && *i == v)
+      return false;
+    values.insert(i, v);
+    if (++card > (unsigned int) array_max)
+      to_bitmap();
+    return true;
+  }
+  __bit_word& w = bits[v / __WORD_BIT];
+  const __bit_word m = __bit_word(1) << (v % __WORD_BIT);
+  if (w & m)
+    return false;
+  w |= m;
+  ++card;
+  return true;
+}
+
+template <class Alloc>
+bool __roaring_chunk<Alloc>::erase(unsigned short v)
+{
+  if (kind == run_kind)
+    to_plain();
+  if (kind == array_kind) {
+    typename value_vector::iterator i =
+      lower_bound(values.begin(), values.end(), v);
+    if (i == values.end() || *i != v)
+      return false;
+    values.erase(i);
+    --card;
+    return true;
+  }
+  __bit_word& w = bits[v / __WORD_BIT];
+  const __bit_word m = __bit_word(1) << (v % __WORD_BIT);
+  if (!(w & m))
+    return false;
+  w &= ~m;
+  if (--card <= (unsigned int) array_max)
+    to_array();
+  return true;
+}
+
+template <class Alloc>
+void __roaring_chunk<Alloc>::copy_bitmap(word_vector& w) const
+{
+  if (kind == bitmap_kind) {
+    w = bits;
+    return;
+  }
+  word_vector tmp(chunk_words, __bit_word(0));
+  if (kind == array_kind)
+    for (size_type i = 0; i < values.size(); ++i)
+      tmp[values[i] / __WORD_BIT] |=
+        __bit_word(1) << (values[i] % __WORD_BIT);
+  else {
+    __bit_iterator first(&*tmp.begin(), 0);
+    for (size_type r = 0; r < run_count(); ++r)
+      fill(first + values[2 * r], first + (values[2 * r + 1] + 1), true);
+  }
+  w.swap(tmp);
+}
+
+template <class Alloc>
+void __roaring_chunk<Alloc>::to_bitmap()
+{
+  copy_bitmap(bits);
+  value_vector().swap(values);
+  kind = bitmap_kind;
+}
+
+template <class Alloc>
+void __roaring_chunk<Alloc>::to_array()
+{
+  value_vector v;
+  v.reserve(card);
+  if (kind == bitmap_kind) {
+    for (size_type i = 0; i < (size_type) chunk_words; ++i)
+      for (__bit_word x = bits[i]; x != 0; x &= x - 1)
+        v.push_back((unsigned short) (i * __WORD_BIT + __bit_lowest(x)));
+  }
+  else
+    for (size_type r = 0; r < run_count(); ++r)
+      for (unsigned int u = values[2 * r]; u <= values[2 * r + 1]; ++u)
+        v.push_back((unsigned short) u);
+  values.swap(v);
+  word_vector().swap(bits);
+  kind = array_kind;
+}
+
+template <class Alloc>
+void __roaring_chunk<Alloc>::to_run()
+{
+  value_vector v;
+  v.reserve(2 * count_runs());
+  if (kind == array_kind) {
+    for (size_type i = 0; i < values.size(); ) {
+      size_type j = i + 1;
+      while (j < values.size() && values[j] == values[j - 1] + 1)
+        ++j;
+      v.push_back(values[i]);
+      v.push_back(values[j - 1]);
+      i = j;
+    }
+  }
+  else {
+    const __bit_const_iterator first = bits_begin();
+    const __bit_const_iterator last = first + chunk_bits;
+    __bit_const_iterator i = find(first, last, true);
+    while (i != last) {
+      __bit_const_iterator j = find(i, last, false);
+      v.push_back((unsigned short) (i - first));
+      v.push_back((unsigned short) (j - first - 1));
+      i = find(j, last, true);
+    }
+  }
+  values.swap(v);
+  word_vector().swap(bits);
+  kind = run_kind;
+}
+
+template <class Alloc>
+typename __roaring_chunk<Alloc>::size_type
+__roaring_chunk<Alloc>::count_runs() const
+{
+  size_type n = 0;
+  if (kind == run_kind)
+    n = run_count();
+  else if (kind == array_kind) {
+    for (size_type i = 0; i < values.size(); ++i)
+      if (i == 0 || values[i] != values[i - 1] + 1)
+        ++n;
+  }
+  else {
+    __bit_word carry = 0;       // top bit of the previous word
+    for (size_type i = 0; i < (size_type) chunk_words; ++i) {
+      const __bit_word x = bits[i];
+      n += __bit_popcount(x & ~((x << 1) | carry));
+      carry = x >> (__WORD_BIT - 1);
+    }
+  }
+  return n;
+}
+
+template <class Alloc>
+void __roaring_chunk<Alloc>::intersect(const __roaring_chunk<Alloc>& x)
+{
+  if (kind == array_kind || x.kind == array_kind) {
+    value_vector v;
+    if (kind == array_kind && x.kind == array_kind)
+      set_intersection(values.begin(), values.end(),
+                       x.values.begin(), x.values.end(), back_inserter(v));
+    else {
+      const __roaring_chunk<Alloc>& a = kind == array_kind ? *this : x;
+      const __roaring_chunk<Alloc>& b = kind == array_kind ? x : *this;
+      for (size_type i = 0; i < a.values.size(); ++i)
+        if (b.contains(a.values[i]))
+          v.push_back(a.values[i]);
+    }
+    values.swap(v);
+    word_vector().swap(bits);
+    kind = array_kind;
+    card = (unsigned int) values.size();
+    return;
+  }
+  if (kind != bitmap_kind)
+    to_bitmap();
+  word_vector tmp;
+  const word_vector& w = x.kind == bitmap_kind ? x.bits
+                                               : (x.copy_bitmap(tmp), tmp);
+  for (size_type i = 0; i < (size_type) chunk_words; ++i)
+    bits[i] &= w[i];
+  recount();
+  to_plain();
+}
+
+template <class Alloc>
+void __roaring_chunk<Alloc>::unite(const __roaring_chunk<Alloc>& x)
+{
+  if (kind == array_kind && x.kind == array_kind) {
+    value_vector v;
+    v.reserve(values.size() + x.values.size());
+    set_union(values.begin(), values.end(),
+              x.values.begin(), x.values.end(), back_inserter(v));
+    values.swap(v);
+    card = (unsigned int) values.size();
+    to_plain();
+    return;
+  }
+  if (kind != bitmap_kind)
+    to_bitmap();
+  if (x.kind == array_kind) {
+    for (size_type i = 0; i < x.values.size(); ++i)
+      bits[x.values[i] / __WORD_BIT] |=
+        __bit_word(1) << (x.values[i] % __WORD_BIT);
+  }
+  else {
+    word_vector tmp;
+    const word_vector& w = x.kind == bitmap_kind ? x.bits
+                                                 : (x.copy_bitmap(tmp), tmp);
+    for (size_type i = 0; i < (size_type) chunk_words; ++i)
+      bits[i] |= w[i];
+  }
+  recount();
+  to_plain();
+}
+
+template <class Alloc>
+void __roaring_chunk<Alloc>::subtract(const __roaring_chunk<Alloc>& x)
+{
+  if (kind == run_kind)
+    to_plain();
+  if (kind == array_kind) {
+    value_vector v;
+    if (x.kind == array_kind)
+      set_difference(values.begin(), values.end(),
+                     x.values.begin(), x.values.end(), back_inserter(v));
+    else
+      for (size_type i = 0; i < values.size(); ++i)
+        if (!x.contains(values[i]))
+          v.push_back(values[i]);
+    values.swap(v);
+    card = (unsigned int) values.size();
+    return;
+  }
+  if (x.kind == array_kind) {
+    for (size_type i = 0; i < x.values.size(); ++i)
+      bits[x.values[i] / __WORD_BIT] &=
+        ~(__bit_word(1) << (x.values[i] % __WORD_BIT));
+  }
+  else {
+    word_vector tmp;
+    const word_vector& w = x.kind == bitmap_kind ? x.bits
+                                                 : (x.copy_bitmap(tmp), tmp);
+    for (size_type i = 0; i < (size_type) chunk_words; ++i)
+      bits[i] &= ~w[i];
+  }
+  recount();
+  to_plain();
+}
+
+template <class Alloc>
+struct __roaring_iterator {
+  typedef unsigned int value_type;
+  typedef const unsigned int& reference;
+  typedef const unsigned int* pointer;
+  typedef forward_iterator_tag iterator_category;
+  typedef ptrdiff_t difference_type;
+  typedef size_t size_type;
+  typedef __roaring_iterator<Alloc> self;
+  typedef __roaring_chunk<Alloc> chunk;
+
+  const chunk* cur;
+  const chunk* last;
+  size_type j;                  // index of the current array value or run
+  unsigned int low;             // low 16 bits of the current value
+  unsigned int value;
+
+  __roaring_iterator() : cur(0), last(0), j(0), low(0), value(0) {}
+  __roaring_iterator(const chunk* first, const chunk* l)
+    : cur(first), last(l), j(0), low(0), value(0) { enter_chunk(); }
+
+  void set_value() { value = ((unsigned int) cur->key << 16) | low; }
+  void enter_chunk() {
+    if (cur != last) {
+      j = 0;
+      low = cur->kind == chunk::bitmap_kind ? cur->next_bit(0)
+                                            : cur->values[0];
+      set_value();
+    }
+  }
+
+  reference operator*() const { return value; }
+#ifndef __SGI_STL_NO_ARROW_OPERATOR
+  pointer operator->() const { return &(operator*()); }
+#endif /* __SGI_STL_NO_ARROW_OPERATOR */
+
+  void increment() {
+    if (cur->kind == chunk::array_kind) {
+      if (++j < cur->values.size()) {
+        low = cur->values[j];
+        set_value();
+        return;
+      }
+    }
+    else if (cur->kind == chunk::bitmap_kind) {
+      low = cur->next_bit(low + 1);
+      if (low < (unsigned int) chunk::chunk_bits) {
+        set_value();
+        return;
+      }
+    }
+    else {
+      if (low < cur->values[2 * j + 1]) {
+        ++low;
+        set_value();
+        return;
+      }
+      if (++j < cur->run_count()) {
+        low = cur->values[2 * j];
+        set_value();
+        return;
+      }
+    }
+    ++cur;
+    enter_chunk();
+  }
+
+  self& operator++() { increment(); return *this; }
+  self operator++(int) {
+    self tmp = *this;
+    increment();
+    return tmp;
+  }
+
+  bool operator==(const self& x) const {
+    return cur == x.cur && (cur == last || low == x.low);
+  }
+  bool operator!=(const self& x) const { return !(*this == x); }
+};
+
+#ifndef __STL_CLASS_PARTIAL_SPECIALIZATION
+
+template <class Alloc>
+inline forward_iterator_tag
+iterator_category(const __roaring_iterator<Alloc>&) {
+  return forward_iterator_tag();
+}
+
+template <class Alloc>
+inline ptrdiff_t*
+distance_type(const __roaring_iterator<Alloc>&) {
+  return (ptrdiff_t*) 0;
+}
+
+template <class Alloc>
+inline unsigned int* value_type(const __roaring_iterator<Alloc>&) {
+  return (unsigned int*) 0;
+}
+
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
+template <class Alloc = alloc>
+class roaring_bitmap {
+public:
+  typedef unsigned int key_type;
+  typedef unsigned int value_type;
+  typedef const value_type* pointer;
+  typedef const value_type* const_pointer;
+  typedef const value_type& reference;
+  typedef const value_type& const_reference;
+  typedef __roaring_iterator<Alloc> const_iterator;
+  typedef const_iterator iterator;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+protected:
+  typedef __roaring_chunk<Alloc> chunk;
+  typedef vector<chunk, Alloc> chunk_vector;
+
+  chunk_vector c;               // sorted by key, none of them empty
+  size_type n;
+
+  static unsigned short high(value_type x) {
+    return (unsigned short) (x >> 16);
+  }
+  static unsigned short low(value_type x) { return (unsigned short) x; }
+
+  // Index of the first chunk whose key is not less than key.
+  size_type lower_chunk(unsigned short key) const {
+    size_type lo = 0;
+    size_type hi = c.size();
+    while (lo < hi) {
+      size_type mid = lo + (hi - lo) / 2;
+      if (c[mid].key < key)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    return lo;
+  }
+  void insert_bits(__bit_const_iterator first, __bit_const_iterator last);
+  void recount() {
+    n = 0;
+    for (size_type i = 0; i < c.size(); ++i)
+      n += c[i].card;
+  }
+
+public:
+  roaring_bitmap() : n(0) {}
+
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class InputIterator>
+  roaring_bitmap(InputIterator first, InputIterator last) : n(0) {
+    insert(first, last);
+  }
+#else
+  roaring_bitmap(const value_type* first, const value_type* last) : n(0) {
+    insert(first, last);
+  }
+#endif /* __STL_MEMBER_TEMPLATES */
+
+  // The positions of the set bits in [first, last).
+  roaring_bitmap(__bit_const_iterator first, __bit_const_iterator last)
+    : n(0) { insert_bits(first, last); }
+  // Without this the member template would take bit_vector::iterator and
+  // insert the bit values instead of their positions.
+  roaring_bitmap(__bit_iterator first, __bit_iterator last)
+    : n(0) { insert_bits(first, last); }
+
+  const_iterator begin() const {
+    return const_iterator(c.begin(), c.end());
+  }
+  const_iterator end() const { return const_iterator(c.end(), c.end()); }
+  bool empty() const { return n == 0; }
+  size_type size() const { return n; }
+  void swap(roaring_bitmap<Alloc>& x) {
+    c.swap(x.c);
+    __STD::swap(n, x.n);
+  }
+
+  size_type count(value_type x) const {
+    size_type i = lower_chunk(high(x));
+    return i != c.size() && c[i].key == high(x) && c[i].contains(low(x));
+  }
+
+  // Returns whether x was added.
+  bool insert(value_type x) {
+    size_type i = lower_chunk(high(x));
+    if (i == c.size() || c[i].key != high(x))
+      c.insert(c.begin() + i, chunk(high(x)));
+    if (!c[i].insert(low(x)))
+      return false;
+    ++n;
+    return true;
+  }
+
+  // Fastest when [first, last) is sorted.
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+#else
+  void insert(const value_type* first, const value_type* last) {
+#endif /* __STL_MEMBER_TEMPLATES */
+    size_type i = c.size();
+    for ( ; first != last; ++first) {
+      const value_type x = *first;
+      if (i == c.size() || c[i].key != high(x)) {
+        i = lower_chunk(high(x));
+        if (i == c.size() || c[i].key != high(x))
+          c.insert(c.begin() + i, chunk(high(x)));
+      }
+      if (c[i].insert(low(x)))
+        ++n;
+    }
+  }
+
+  size_type erase(value_type x) {
+    size_type i = lower_chunk(high(x));
+    if (i == c.size() || c[i].key != high(x) || !c[i].erase(low(x)))
+      return 0;
+    if (c[i].card == 0)
+      c.erase(c.begin() + i);
+    --n;
+    return 1;
+  }
+  void clear() {
+    c.clear();
+    n = 0;
+  }
+
+  // Converts each chunk to runs where that takes less memory.
+  void optimize() {
+    for (size_type i = 0; i < c.size(); ++i)
+      c[i].optimize();
+  }
+
+  // Sets [first, last) to the values below last - first.
+  void copy_bits(__bit_iterator first, __bit_iterator last) const;
+
+  roaring_bitmap<Alloc>& operator&=(const roaring_bitmap<Alloc>& x);
+  roaring_bitmap<Alloc>& operator|=(const roaring_bitmap<Alloc>& x);
+  roaring_bitmap<Alloc>& operator-=(const roaring_bitmap<Alloc>& x);
+};
+
+// Only called on an empty bitmap.
+template <class Alloc>
+void roaring_bitmap<Alloc>::insert_bits(__bit_const_iterator first,
+                                        __bit_const_iterator last)
+{
+  const size_type len = last - first;
+  for (size_type base = 0; base < len; base += chunk::chunk_bits) {
+    const __bit_const_iterator f = first + base;
+    const __bit_const_iterator l =
+      first + min(len, base + (size_type) chunk::chunk_bits);
+    size_type k = 0;
+    __STD::count(f, l, true, k);
+    if (k == 0)
+      continue;
+    c.push_back(chunk(high(value_type(base))));
+    chunk& ch = c.back();
+    if (k > (size_type) chunk::array_max) {
+      ch.kind = chunk::bitmap_kind;
+      ch.bits.insert(ch.bits.end(), (size_type) chunk::chunk_words,
+                     __bit_word(0));
+      copy(f, l, ch.bits_begin());
+    }
+    else {
+      ch.values.reserve(k);
+      for (__bit_const_iterator i = find(f, l, true); i != l;
+           i = find(i + 1, l, true))
+        ch.values.push_back((unsigned short) (i - f));
+    }
+    ch.card = (unsigned int) k;
+    n += k;
+  }
+}
+
+template <class Alloc>
+void roaring_bitmap<Alloc>::copy_bits(__bit_iterator first,
+                                      __bit_iterator last) const
+{
+  fill(first, last, false);
+  const size_type len = last - first;
+  for (size_type i = 0; i < c.size(); ++i) {
+    const chunk& ch = c[i];
+    const size_type base = size_type(ch.key) << 16;
+    if (base >= len)
+      break;
+    const unsigned int lim =
+      (unsigned int) min(len - base, (size_type) chunk::chunk_bits);
+    const __bit_iterator f = first + base;
+    if (ch.kind == chunk::bitmap_kind)
+      copy(ch.bits_begin(), ch.bits_begin() + lim, f);
+    else if (ch.kind == chunk::array_kind) {
+      for (size_type j = 0; j < ch.values.size() && ch.values[j] < lim; ++j)
+        *(f + ch.values[j]) = true;
+    }
+    else
+      for (size_type r = 0; r < ch.run_count() && ch.values[2 * r] < lim;
+           ++r)
+        fill(f + ch.values[2 * r],
+             f + min(ch.values[2 * r + 1] + 1U, lim), true);
+  }
+}
+
+template <class Alloc>
+roaring_bitmap<Alloc>&
+roaring_bitmap<Alloc>::operator&=(const roaring_bitmap<Alloc>& x)
+{
+  if (this == &x)
+    return *this;
+  size_type i = 0;
+  size_type j = 0;
+  size_type out = 0;
+  while (i < c.size() && j < x.c.size()) {
+    if (c[i].key < x.c[j].key)
+      ++i;
+    else if (x.c[j].key < c[i].key)
+      ++j;
+    else {
+      c[i].intersect(x.c[j]);
+      if (c[i].card != 0) {
+        if (out != i)
+          c[out].swap(c[i]);
+        ++out;
+      }
+      ++i;
+      ++j;
+    }
+  }
+  c.erase(c.begin() + out, c.end());
+  recount();
+  return *this;
+}
+
+template <class Alloc>
+roaring_bitmap<Alloc>&
+roaring_bitmap<Alloc>::operator|=(const roaring_bitmap<Alloc>& x)
+{
+  if (this == &x)
+    return *this;
+  chunk_vector r;
+  r.reserve(c.size() + x.c.size());
+  size_type i = 0;
+  size_type j = 0;
+  while (i < c.size() || j < x.c.size()) {
+    if (j == x.c.size() || (i < c.size() && c[i].key < x.c[j].key)) {
+      r.push_back(chunk(c[i].key));
+      r.back().swap(c[i++]);
+    }
+    else if (i == c.size() || x.c[j].key < c[i].key)
+      r.push_back(x.c[j++]);
+    else {
+      r.push_back(chunk(c[i].key));
+      r.back().swap(c[i++]);
+      r.back().unite(x.c[j++]);
+    }
+  }
+  c.swap(r);
+  recount();
+  return *this;
+}
+
+template <class Alloc>
+roaring_bitmap<Alloc>&
+roaring_bitmap<Alloc>::operator-=(const roaring_bitmap<Alloc>& x)
+{
+  if (this == &x) {
+    clear();
+    return *this;
+  }
+  size_type j = 0;
+  size_type out = 0;
+  for (size_type i = 0; i < c.size(); ++i) {
+    while (j < x.c.size() && x.c[j].key < c[i].key)
+      ++j;
+    if (j < x.c.size() && x.c[j].key == c[i].key)
+      c[i].subtract(x.c[j]);
+    if (c[i].card != 0) {
+      if (out != i)
+        c[out].swap(c[i]);
+      ++out;
+    }
+  }
+  c.erase(c.begin() + out, c.end());
+  recount();
+  return *this;
+}
+
+template <class Alloc>
+inline roaring_bitmap<Alloc> operator&(const roaring_bitmap<Alloc>& x,
+                                       const roaring_bitmap<Alloc>& y) {
+  roaring_bitmap<Alloc> tmp(x);
+  return tmp &= y;
+}
+
+template <class Alloc>
+inline roaring_bitmap<Alloc> operator|(const roaring_bitmap<Alloc>& x,
+                                       const roaring_bitmap<Alloc>& y) {
+  roaring_bitmap<Alloc> tmp(x);
+  return tmp |= y;
+}
+
+template <class Alloc>
+inline roaring_bitmap<Alloc> operator-(const roaring_bitmap<Alloc>& x,
+                                       const roaring_bitmap<Alloc>& y) {
+  roaring_bitmap<Alloc> tmp(x);
+  return tmp -= y;
+}
+
+template <class Alloc>
+inline bool operator==(const roaring_bitmap<Alloc>& x,
+                       const roaring_bitmap<Alloc>& y) {
+  return x.size() == y.size() && equal(x.begin(), x.end(), y.begin());
+}
+
+#ifdef __STL_FUNCTION_TMPL_PARTIAL_ORDER
+
+template <class Alloc>
+inline void swap(roaring_bitmap<Alloc>& x, roaring_bitmap<Alloc>& y) {
+  x.swap(y);
+}
+
+#endif /* __STL_FUNCTION_TMPL_PARTIAL_ORDER */
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma reset woff 1174
+#endif
+
+__STL_END_NAMESPACE
+
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+
+template <class Alloc>
+struct __relocate_traits<__STD::__roaring_chunk<Alloc> > {
+  typedef __true_type is_trivially_relocatable;
+};
+
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
+#endif /* __SGI_STL_INTERNAL_ROARING_H */
+
+// Local Variables:
+// mode:C++
+// End:
@@ -733,6 +733,15 @@ void slist<T,Alloc>::sort(StrictWeakOrdering comp)
 
 __STL_END_NAMESPACE 
 
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+
+template <class T, class Alloc>
+struct __relocate_traits<__STD::slist<T, Alloc> > {
+  typedef __true_type is_trivially_relocatable;
+};
+
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
 #endif /* __SGI_STL_INTERNAL_SLIST_H */
 
 // Local Variables:
@@ -0,0 +1,525 @@
+/*
+ * Copyright (c) 1997
+ * Silicon Graphics Computer Systems, Inc.
+ *
+ * Permission to use, copy, modify, distribute and sell this software
+ * and its documentation for any purpose is hereby granted without fee,
+ * provided that the above copyright notice appear in all copies and
+ * that both that copyright notice and this permission notice appear
+ * in supporting documentation.  Silicon Graphics makes no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ */
+
+/* NOTE: This is an internal header file, included by other STL headers.
+ *   You should not attempt to use it directly.
+ */
+
+#ifndef __SGI_STL_INTERNAL_SMALL_VECTOR_H
+#define __SGI_STL_INTERNAL_SMALL_VECTOR_H
+
+#include <stl_vector.h>
+
+/*
+
+A vector that holds up to N elements in a buffer inside the object
+itself and only allocates from Alloc once it grows beyond that.  It has
+the interface of vector, and its storage management follows vector:
+start, finish and end_of_storage delimit the elements and the capacity,
+Growth is one of vector's growth policies, and insertion and erasure
+within a block are done by the same __vector_* functions.
+
+A small_vector whose elements are in the inline buffer points into
+itself, so unlike vector it is not trivially relocatable, and swap is
+linear rather than constant time unless both vectors have spilled to
+the heap.  The capacity never drops below N.
+
+*/
+
+__STL_BEGIN_NAMESPACE
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma set woff 1174
+#endif
+
+// __alignment_of<T>::value is the alignment T has as a class member.
+template <class T>
+struct __alignment_of {
+  struct helper { char c; T t; };
+  enum { value = sizeof(helper) - sizeof(T) };
+};
+
+union __max_align_unit {
+  long double align_long_double;
+  double align_double;
+  long align_long;
+  void* align_pointer;
+};
+
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+
+// __align_pick<T, U, Else>::type is U if U is aligned at least as
+// strictly as T, and Else if not.
+template <bool Fits, class U, class Else>
+struct __align_select { typedef U type; };
+
+template <class U, class Else>
+struct __align_select<false, U, Else> { typedef Else type; };
+
+template <class T, class U, class Else>
+struct __align_pick
+  : public __align_select<((int) __alignment_of<T>::value
+                           <= (int) __alignment_of<U>::value), U, Else> {};
+
+// The first of char, short, int, long, double and long double that is
+// aligned at least as strictly as T, or __max_align_unit if none is.
+template <class T>
+struct __aligned_unit {
+  typedef typename __align_pick<T, long double, __max_align_unit>::type u5;
+  typedef typename __align_pick<T, double, u5>::type u4;
+  typedef typename __align_pick<T, long, u4>::type u3;
+  typedef typename __align_pick<T, int, u3>::type u2;
+  typedef typename __align_pick<T, short, u2>::type u1;
+  typedef typename __align_pick<T, char, u1>::type type;
+};
+
+#else /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
+template <class T>
+struct __aligned_unit {
+  typedef __max_align_unit type;
+};
+
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
+template <class T, size_t N, class Alloc = alloc,
+          class Growth = vector_growth_2x>
+class small_vector {
+public:
+  typedef T value_type;
+  typedef value_type* pointer;
+  typedef const value_type* const_pointer;
+  typedef value_type* iterator;
+  typedef const value_type* const_iterator;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+  typedef reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef reverse_iterator<iterator> reverse_iterator;
+#else /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+  typedef reverse_iterator<const_iterator, value_type, const_reference,
+                           difference_type>  const_reverse_iterator;
+  typedef reverse_iterator<iterator, value_type, reference, difference_type>
+          reverse_iterator;
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
+protected:
+  typedef simple_alloc<value_type, Alloc> data_allocator;
+  typedef typename __relocate_traits<T>::is_trivially_relocatable
+          relocatable;
+
+  // Raw room for N elements (one if N is 0), aligned for T.
+  typedef typename __aligned_unit<T>::type buffer_unit;
+  enum { buffer_units = ((N != 0 ? N : 1) * sizeof(T) + sizeof(buffer_unit)
+                         - 1) / sizeof(buffer_unit) };
+
+  iterator start;
+  iterator finish;
+  iterator end_of_storage;
+  buffer_unit buffer[buffer_units];
+
+  iterator inline_start() { return (iterator) buffer; }
+  bool is_inline() const { return start == (const_iterator) buffer; }
+
+  void init_storage() {
+    start = finish = inline_start();
+    end_of_storage = start + N;
+  }
+  void deallocate() {
+    if (!is_inline())
+      data_allocator::deallocate(start, end_of_storage - start);
+  }
+  // Makes sure an empty, freshly initialized vector can hold n elements.
+  void allocate_for(size_type n) {
+    if (n > N) {
+      start = finish = data_allocator::allocate(n);
+      end_of_storage = start + n;
+    }
+  }
+  void fill_initialize(size_type n, const T& value) {
+    init_storage();
+    allocate_for(n);
+    __STL_TRY {
+      finish = uninitialized_fill_n(start, n, value);
+    }
+    __STL_UNWIND(deallocate());
+  }
+
+  size_type next_capacity(size_type n) const {
+    return Growth::capacity(size(), n, sizeof(T));
+  }
+  void insert_aux(iterator position, const T& x);
+
+public:
+  iterator begin() { return start; }
+  const_iterator begin() const { return start; }
+  iterator end() { return finish; }
+  const_iterator end() const { return finish; }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+  size_type size() const { return size_type(end() - begin()); }
+  size_type max_size() const { return size_type(-1) / sizeof(T); }
+  size_type capacity() const { return size_type(end_of_storage - begin()); }
+  static size_type inline_capacity() { return N; }
+  bool empty() const { return begin() == end(); }
+  reference operator[](size_type n) { return *(begin() + n); }
+  const_reference operator[](size_type n) const { return *(begin() + n); }
+
+  small_vector() { init_storage(); }
+  small_vector(size_type n, const T& value) { fill_initialize(n, value); }
+  small_vector(int n, const T& value) { fill_initialize(n, value); }
+  small_vector(long n, const T& value) { fill_initialize(n, value); }
+  explicit small_vector(size_type n) { fill_initialize(n, T()); }
+
+  small_vector(const small_vector<T, N, Alloc, Growth>& x) {
+    init_storage();
+    range_initialize(x.begin(), x.end(), forward_iterator_tag());
+  }
+
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class InputIterator>
+  small_vector(InputIterator first, InputIterator last) {
+    init_storage();
+    range_initialize(first, last, iterator_category(first));
+  }
+#else /* __STL_MEMBER_TEMPLATES */
+  small_vector(const_iterator first, const_iterator last) {
+    init_storage();
+    range_initialize(first, last, forward_iterator_tag());
+  }
+#endif /* __STL_MEMBER_TEMPLATES */
+
+  ~small_vector() {
+    destroy(start, finish);
+    deallocate();
+  }
+  small_vector<T, N, Alloc, Growth>&
+  operator=(const small_vector<T, N, Alloc, Growth>& x);
+  void reserve(size_type n) {
+    if (capacity() < n) {
+      iterator tmp = data_allocator::allocate(n);
+      iterator tmp_finish = tmp;
+      __STL_TRY {
+        tmp_finish = relocate_around(finish, tmp, 0);
+      }
+      __STL_UNWIND(data_allocator::deallocate(tmp, n));
+      deallocate();
+      start = tmp;
+      finish = tmp_finish;
+      end_of_storage = start + n;
+    }
+  }
+  reference front() { return *begin(); }
+  const_reference front() const { return *begin(); }
+  reference back() { return *(end() - 1); }
+  const_reference back() const { return *(end() - 1); }
+  void push_back(const T& x) {
+    if (finish != end_of_storage) {
+      construct(finish, x);
+      ++finish;
+    }
+    else
+      insert_aux(end(), x);
+  }
+  void swap(small_vector<T, N, Alloc, Growth>& x) {
+    if (!is_inline() && !x.is_inline()) {
+      __STD::swap(start, x.start);
+      __STD::swap(finish, x.finish);
+      __STD::swap(end_of_storage, x.end_of_storage);
+    }
+    else if (this != &x) {
+      small_vector<T, N, Alloc, Growth> tmp(*this);
+      *this = x;
+      x = tmp;
+    }
+  }
+  iterator insert(iterator position, const T& x) {
+    size_type n = position - begin();
+    if (finish != end_of_storage && position == end()) {
+      construct(finish, x);
+      ++finish;
+    }
+    else
+      insert_aux(position, x);
+    return begin() + n;
+  }
+  iterator insert(iterator position) { return insert(position, T()); }
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class InputIterator>
+  void insert(iterator position, InputIterator first, InputIterator last) {
+    range_insert(position, first, last, iterator_category(first));
+  }
+#else /* __STL_MEMBER_TEMPLATES */
+  void insert(iterator position,
+              const_iterator first, const_iterator last);
+#endif /* __STL_MEMBER_TEMPLATES */
+
+  void insert (iterator pos, size_type n, const T& x);
+  void insert (iterator pos, int n, const T& x) {
+    insert(pos, (size_type) n, x);
+  }
+  void insert (iterator pos, long n, const T& x) {
+    insert(pos, (size_type) n, x);
+  }
+
+  void pop_back() {
+    --finish;
+    destroy(finish);
+  }
+  iterator erase(iterator position) {
+    return __vector_erase(position, position + 1, finish, relocatable());
+  }
+  iterator erase(iterator first, iterator last) {
+    return __vector_erase(first, last, finish, relocatable());
+  }
+  void resize(size_type new_size, const T& x) {
+    if (new_size < size())
+      erase(begin() + new_size, end());
+    else
+      insert(end(), new_size - size(), x);
+  }
+  void resize(size_type new_size) { resize(new_size, T()); }
+  void clear() { erase(begin(), end()); }
+
+protected:
+  // See __vector_relocate_around.
+  iterator relocate_around(iterator position, iterator new_start,
+                           size_type n) {
+    return __vector_relocate_around(start, finish, position, new_start, n,
+                                    relocatable());
+  }
+
+  // Replaces the storage with the heap block [new_start, new_start + len)
+  // holding the elements up to new_finish.
+  void adopt(iterator new_start, iterator new_finish, size_type len) {
+    deallocate();
+    start = new_start;
+    finish = new_finish;
+    end_of_storage = new_start + len;
+  }
+
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class InputIterator>
+  void range_initialize(InputIterator first, InputIterator last,
+                        input_iterator_tag) {
+    __STL_TRY {
+      for ( ; first != last; ++first)
+        push_back(*first);
+    }
+    __STL_UNWIND((destroy(start, finish), deallocate()));
+  }
+#endif /* __STL_MEMBER_TEMPLATES */
+
+#ifndef __STL_MEMBER_TEMPLATES
+  typedef const_iterator ForwardIterator;
+#endif /* __STL_MEMBER_TEMPLATES */
+
+  // Only called by the constructors, on an empty vector with inline
+  // storage.
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class ForwardIterator>
+#endif /* __STL_MEMBER_TEMPLATES */
+  void range_initialize(ForwardIterator first, ForwardIterator last,
+                        forward_iterator_tag) {
+    size_type n = 0;
+    distance(first, last, n);
+    allocate_for(n);
+    __STL_TRY {
+      finish = uninitialized_copy(first, last, start);
+    }
+    __STL_UNWIND(deallocate());
+  }
+
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class InputIterator>
+  void range_insert(iterator pos,
+                    InputIterator first, InputIterator last,
+                    input_iterator_tag);
+
+  template <class ForwardIterator>
+  void range_insert(iterator pos,
+                    ForwardIterator first, ForwardIterator last,
+                    forward_iterator_tag);
+#endif /* __STL_MEMBER_TEMPLATES */
+};
+
+template <class T, size_t N, class Alloc, class Growth>
+inline bool operator==(const small_vector<T, N, Alloc, Growth>& x,
+                       const small_vector<T, N, Alloc, Growth>& y) {
+  return x.size() == y.size() && equal(x.begin(), x.end(), y.begin());
+}
+
+template <class T, size_t N, class Alloc, class Growth>
+inline bool operator<(const small_vector<T, N, Alloc, Growth>& x,
+                      const small_vector<T, N, Alloc, Growth>& y) {
+  return lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+#ifdef __STL_FUNCTION_TMPL_PARTIAL_ORDER
+
+template <class T, size_t N, class Alloc, class Growth>
+inline void swap(small_vector<T, N, Alloc, Growth>& x,
+                 small_vector<T, N, Alloc, Growth>& y) {
+  x.swap(y);
+}
+
+#endif /* __STL_FUNCTION_TMPL_PARTIAL_ORDER */
+
+template <class T, size_t N, class Alloc, class Growth>
+small_vector<T, N, Alloc, Growth>&
+small_vector<T, N, Alloc, Growth>::operator=(
+    const small_vector<T, N, Alloc, Growth>& x) {
+  if (&x != this) {
+    if (x.size() > capacity()) {
+      const size_type len = x.size();
+      iterator tmp = data_allocator::allocate(len);
+      __STL_TRY {
+        uninitialized_copy(x.begin(), x.end(), tmp);
+      }
+      __STL_UNWIND(data_allocator::deallocate(tmp, len));
+      destroy(start, finish);
+      adopt(tmp, tmp + len, len);
+    }
+    else if (size() >= x.size()) {
+      iterator i = copy(x.begin(), x.end(), begin());
+      destroy(i, finish);
+      finish = start + x.size();
+    }
+    else {
+      copy(x.begin(), x.begin() + size(), start);
+      finish = uninitialized_copy(x.begin() + size(), x.end(), finish);
+    }
+  }
+  return *this;
+}
+
+template <class T, size_t N, class Alloc, class Growth>
+void small_vector<T, N, Alloc, Growth>::insert_aux(iterator position,
+                                                   const T& x) {
+  if (finish != end_of_storage)
+    __vector_insert(position, finish, x, relocatable());
+  else {
+    const size_type len = next_capacity(1);
+    iterator new_start = data_allocator::allocate(len);
+    iterator new_position = new_start + (position - start);
+    iterator new_finish = new_start;
+    __STL_TRY {
+      construct(new_position, x);
+      __STL_TRY {
+        new_finish = relocate_around(position, new_start, 1);
+      }
+      __STL_UNWIND(destroy(new_position));
+    }
+    __STL_UNWIND(data_allocator::deallocate(new_start, len));
+    adopt(new_start, new_finish, len);
+  }
+}
+
+template <class T, size_t N, class Alloc, class Growth>
+void small_vector<T, N, Alloc, Growth>::insert(iterator position,
+                                               size_type n, const T& x) {
+  if (n != 0) {
+    if (size_type(end_of_storage - finish) >= n)
+      __vector_fill_insert(position, finish, n, x, relocatable());
+    else {
+      const size_type len = next_capacity(n);
+      iterator new_start = data_allocator::allocate(len);
+      iterator new_position = new_start + (position - start);
+      iterator new_finish = new_start;
+      __STL_TRY {
+        uninitialized_fill_n(new_position, n, x);
+        __STL_TRY {
+          new_finish = relocate_around(position, new_start, n);
+        }
+        __STL_UNWIND(destroy(new_position, new_position + n));
+      }
+      __STL_UNWIND(data_allocator::deallocate(new_start, len));
+      adopt(new_start, new_finish, len);
+    }
+  }
+}
+
+#ifdef __STL_MEMBER_TEMPLATES
+
+template <class T, size_t N, class Alloc, class Growth>
+template <class InputIterator>
+void small_vector<T, N, Alloc, Growth>::range_insert(iterator pos,
+                                                     InputIterator first,
+                                                     InputIterator last,
+                                                     input_iterator_tag) {
+  for ( ; first != last; ++first) {
+    pos = insert(pos, *first);
+    ++pos;
+  }
+}
+
+template <class T, size_t N, class Alloc, class Growth>
+template <class ForwardIterator>
+void small_vector<T, N, Alloc, Growth>::range_insert(iterator position,
+                                                     ForwardIterator first,
+                                                     ForwardIterator last,
+                                                     forward_iterator_tag)
+
+#else /* __STL_MEMBER_TEMPLATES */
+
+template <class T, size_t N, class Alloc, class Growth>
+void small_vector<T, N, Alloc, Growth>::insert(iterator position,
+                                               const_iterator first,
+                                               const_iterator last)
+
+#endif /* __STL_MEMBER_TEMPLATES */
+{
+  if (first != last) {
+    size_type n = 0;
+    distance(first, last, n);
+    if (size_type(end_of_storage - finish) >= n)
+      __vector_range_insert(position, finish, first, last, n,
+                            relocatable());
+    else {
+      const size_type len = next_capacity(n);
+      iterator new_start = data_allocator::allocate(len);
+      iterator new_position = new_start + (position - start);
+      iterator new_finish = new_start;
+      __STL_TRY {
+        uninitialized_copy(first, last, new_position);
+        __STL_TRY {
+          new_finish = relocate_around(position, new_start, n);
+        }
+        __STL_UNWIND(destroy(new_position, new_position + n));
+      }
+      __STL_UNWIND(data_allocator::deallocate(new_start, len));
+      adopt(new_start, new_finish, len);
+    }
+  }
+}
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma reset woff 1174
+#endif
+
+__STL_END_NAMESPACE
+
+#endif /* __SGI_STL_INTERNAL_SMALL_VECTOR_H */
+
+// Local Variables:
+// mode:C++
+// End:
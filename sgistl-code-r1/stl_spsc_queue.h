@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 1997
+ * Silicon Graphics Computer Systems, Inc.
+ *
+ * Permission to use, copy, modify, distribute and sell this software
+ * and its documentation for any purpose is hereby granted without fee,
+ * provided that the above copyright notice appear in all copies and
+ * that both that copyright notice and this permission notice appear
+ * in supporting documentation.  Silicon Graphics makes no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ */
+
+/* NOTE: This is an internal header file, included by other STL headers.
+ *   You should not attempt to use it directly.
+ */
+
+#ifndef __SGI_STL_INTERNAL_SPSC_QUEUE_H
+#define __SGI_STL_INTERNAL_SPSC_QUEUE_H
+
+/*
+
+Bounded single-producer, single-consumer FIFO queue.
+
+An spsc_queue is a ring shared by exactly two threads: one that only
+pushes and one that only pops.  Each side owns one index, advances it
+with a release store, and is the only writer of it, so no
+read-modify-write operations are needed at all.  Each side also keeps
+a private copy of the other side's index, and only rereads the shared
+one when that copy says the ring is full (or empty); in the steady
+state the two sides touch each other's cache line once per lap rather
+than once per element.
+
+Besides try_push/try_pop and the blocking push/pop, elements can be
+built and read where they lie.  reserve() hands the producer
+uninitialized storage for the next element(s), which it constructs in
+place and then publishes with commit(); peek() hands the consumer the
+element(s) at the front, which it uses in place and then destroys and
+frees with release().  The forms taking a count return up to that many
+contiguous slots, fewer where the ring wraps around.
+
+The capacity is rounded up to a power of two.  size() is only a
+snapshot while the other thread is active.
+
+*/
+
+__STL_BEGIN_NAMESPACE
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma set woff 1174
+#endif
+
+template <class T, class Alloc = alloc>
+class spsc_queue {
+public:
+  typedef T value_type;
+  typedef value_type* pointer;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+protected:
+  typedef simple_alloc<value_type, Alloc> data_allocator;
+
+  pointer buffer;
+  size_type mask;
+  char pad0[__STL_CACHE_LINE_SIZE];
+  volatile size_type tail;              // written by the producer
+  size_type cached_head;                // the producer's copy of head
+  char pad1[__STL_CACHE_LINE_SIZE];
+  volatile size_type head;              // written by the consumer
+  size_type cached_tail;                // the consumer's copy of tail
+  char pad2[__STL_CACHE_LINE_SIZE];
+
+  // Free slots as the producer sees them, rereading head if fewer than n.
+  size_type room(size_type n) {
+    const size_type t = tail;
+    size_type free = capacity() - (t - cached_head);
+    if (free < n) {
+      cached_head = __stl_atomic_load(&head);
+      free = capacity() - (t - cached_head);
+    }
+    return free;
+  }
+  // Elements as the consumer sees them, rereading tail if fewer than n.
+  size_type ready(size_type n) {
+    const size_type h = head;
+    size_type used = cached_tail - h;
+    if (used < n) {
+      cached_tail = __stl_atomic_load(&tail);
+      used = cached_tail - h;
+    }
+    return used;
+  }
+
+private:
+  spsc_queue(const spsc_queue<T, Alloc>&);
+  spsc_queue<T, Alloc>& operator=(const spsc_queue<T, Alloc>&);
+
+public:
+  explicit spsc_queue(size_type n)
+    : tail(0), cached_head(0), head(0), cached_tail(0) {
+    size_type cap = 1;
+    while (cap < n)
+      cap *= 2;
+    buffer = data_allocator::allocate(cap);
+    mask = cap - 1;
+  }
+  ~spsc_queue() {
+    for (size_type i = head; i != tail; ++i)
+      destroy(buffer + (i & mask));
+    data_allocator::deallocate(buffer, capacity());
+  }
+
+  size_type capacity() const { return mask + 1; }
+  size_type size() const {
+    const size_type h = __stl_atomic_load(&head);
+    return __stl_atomic_load(&tail) - h;
+  }
+  bool empty() const { return size() == 0; }
+
+  // Producer side.
+
+  // Storage for the next element, or 0 if the queue is full.
+  pointer reserve() {
+    return room(1) == 0 ? pointer(0) : buffer + (tail & mask);
+  }
+  // Points p at up to n contiguous free slots; returns how many.
+  size_type reserve(pointer& p, size_type n) {
+    const size_type t = tail & mask;
+    n = min(n, min(room(n), capacity() - t));
+    p = buffer + t;
+    return n;
+  }
+  // Publishes the next n reserved slots, which must have been constructed.
+  void commit(size_type n = 1) { __stl_atomic_store(&tail, tail + n); }
+
+  bool try_push(const T& x) {
+    pointer p = reserve();
+    if (p == 0)
+      return false;
+    construct(p, x);
+    commit();
+    return true;
+  }
+  void push(const T& x) {
+    __stl_backoff wait;
+    while (!try_push(x))
+      wait();
+  }
+
+  // Consumer side.
+
+  // The element at the front, or 0 if the queue is empty.
+  pointer peek() {
+    return ready(1) == 0 ? pointer(0) : buffer + (head & mask);
+  }
+  // Points p at up to n contiguous elements from the front; returns how
+  // many.
+  size_type peek(pointer& p, size_type n) {
+    const size_type h = head & mask;
+    n = min(n, min(ready(n), capacity() - h));
+    p = buffer + h;
+    return n;
+  }
+  // Destroys the n elements at the front and frees their slots.
+  void release(size_type n = 1) {
+    const size_type h = head;
+    for (size_type i = 0; i != n; ++i)
+      destroy(buffer + ((h + i) & mask));
+    __stl_atomic_store(&head, h + n);
+  }
+
+  bool try_pop(T& x) {
+    pointer p = peek();
+    if (p == 0)
+      return false;
+    __STL_TRY {
+      x = *p;
+    }
+    __STL_UNWIND(release());
+    release();
+    return true;
+  }
+  void pop(T& x) {
+    __stl_backoff wait;
+    while (!try_pop(x))
+      wait();
+  }
+};
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma reset woff 1174
+#endif
+
+__STL_END_NAMESPACE
+
+#endif /* __SGI_STL_INTERNAL_SPSC_QUEUE_H */
+
+// Local Variables:
+// mode:C++
+// End:
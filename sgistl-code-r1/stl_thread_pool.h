@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 1997
+ * Silicon Graphics Computer Systems, Inc.
+ *
+ * Permission to use, copy, modify, distribute and sell this software
+ * and its documentation for any purpose is hereby granted without fee,
+ * provided that the above copyright notice appear in all copies and
+ * that both that copyright notice and this permission notice appear
+ * in supporting documentation.  Silicon Graphics makes no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ */
+
+/* NOTE: This is an internal header file, included by other STL headers.
+ *   You should not attempt to use it directly.
+ */
+
+#ifndef __SGI_STL_INTERNAL_THREAD_POOL_H
+#define __SGI_STL_INTERNAL_THREAD_POOL_H
+
+/*
+
+Pool of worker threads for fork-join task parallelism.
+
+A task is a function and an argument.  Each worker owns a
+work_stealing_deque of tasks: tasks submitted by a worker go on its own
+deque, and it runs them newest first; a worker whose deque is empty
+takes tasks submitted from outside the pool, which go through a
+bounded_queue, and failing that steals the oldest task of another
+worker.
+
+A task_group counts the tasks submitted to it that have not finished.
+wait(g) returns when they all have.  A worker that waits runs its own
+tasks and steals others meanwhile, so a task may submit subtasks to a
+group and wait for it without tying up its worker; it does not start
+tasks from outside the pool, which would nest whole computations on its
+stack.  wait() waits for every task submitted to the pool; it is for
+threads outside the pool, and the destructor calls it before it stops
+the workers.  Threads outside the pool only spin and yield while they
+wait.
+
+Idle workers spin, then yield, and after a while sleep on a condition
+variable until a task is submitted or the pool is destroyed.  If no
+worker could be started, submit() runs each task at once.  Tasks must not
+throw.  thread_pool needs pthreads, and is only defined when the
+library is built for them.
+
+*/
+
+#ifdef __STL_PTHREADS
+
+#include <pthread.h>
+
+__STL_BEGIN_NAMESPACE
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma set woff 1174
+#endif
+
+struct task_group {
+  volatile size_t pending;
+
+  task_group() : pending(0) {}
+  bool done() const { return __stl_atomic_load(&pending) == 0; }
+};
+
+struct __thread_pool_task {
+  void (*function)(void*);
+  void* argument;
+  task_group* group;
+};
+
+template <class Alloc = alloc>
+class thread_pool {
+public:
+  typedef void (*function_type)(void*);
+  typedef size_t size_type;
+
+protected:
+  typedef __thread_pool_task task;
+  enum { deque_capacity = 256, injection_capacity = 1024 };
+  enum { idle_rounds = 256 };   // failed searches before a worker sleeps
+
+  struct worker {
+    work_stealing_deque<task, Alloc> tasks;
+    thread_pool<Alloc>* pool;
+    size_type index;
+    pthread_t thread;
+
+    worker(size_type n) : tasks(n) {}
+  };
+  typedef simple_alloc<worker, Alloc> worker_allocator;
+
+  worker* workers;
+  size_type worker_count;
+  size_type started;            // workers whose thread was created
+  pthread_key_t self_key;       // the calling thread's worker, if any
+  bounded_queue<task, Alloc> injected;
+  volatile size_t outstanding;  // tasks submitted and not finished
+  volatile size_t queued;       // tasks submitted and not yet taken
+  volatile size_t stopping;
+  volatile size_t sleepers;     // workers in park()
+  pthread_mutex_t idle_lock;
+  pthread_cond_t idle_cond;
+
+  worker* self() const { return (worker*) pthread_getspecific(self_key); }
+
+  static void* run_worker(void* p) {
+    worker* w = (worker*) p;
+    thread_pool<Alloc>* pool = w->pool;
+    pthread_setspecific(pool->self_key, w);
+    __stl_backoff wait;
+    size_type idle = 0;
+    while (__stl_atomic_load(&pool->stopping) == 0) {
+      if (pool->run_one(w, true)) {
+        wait.reset();
+        idle = 0;
+      }
+      else if (++idle < (size_type) idle_rounds)
+        wait();
+      else {
+        pool->park();
+        wait.reset();
+        idle = 0;
+      }
+    }
+    return 0;
+  }
+  // Sleeps until a task is queued or the pool stops.  sleepers is raised
+  // before queued is checked, and add() raises queued before it checks
+  // sleepers, so one of the two always sees the other.
+  void park() {
+    pthread_mutex_lock(&idle_lock);
+    __stl_atomic_fetch_add(&sleepers, 1);
+    __stl_atomic_fence();
+    while (__stl_atomic_load(&queued) == 0
+           && __stl_atomic_load(&stopping) == 0)
+      pthread_cond_wait(&idle_cond, &idle_lock);
+    __stl_atomic_fetch_add(&sleepers, size_t(-1));
+    pthread_mutex_unlock(&idle_lock);
+  }
+  void wake() {
+    __stl_atomic_fence();
+    if (__stl_atomic_load(&sleepers) != 0) {
+      pthread_mutex_lock(&idle_lock);
+      pthread_cond_signal(&idle_cond);
+      pthread_mutex_unlock(&idle_lock);
+    }
+  }
+
+  void add(const task& t) {
+    __stl_atomic_fetch_add(&outstanding, 1);
+    worker* w = self();
+    if (w == 0 && started == 0) {
+      run(t);
+      return;
+    }
+    __stl_atomic_fetch_add(&queued, 1);
+    if (w)
+      w->tasks.push(t);
+    else
+      injected.push(t);
+    wake();
+  }
+  bool steal(worker* w, task& t) {
+    for (size_type i = 1; i < worker_count; ++i) {
+      worker* victim = workers + (w->index + i) % worker_count;
+      if (victim->tasks.try_steal(t))
+        return true;
+    }
+    return false;
+  }
+  // Runs one task of w's own, or one stolen from another worker or, if
+  // fresh, one submitted from outside; returns whether it did.
+  bool run_one(worker* w, bool fresh) {
+    task t;
+    if (w->tasks.try_pop(t) || (fresh && injected.try_pop(t))
+        || steal(w, t)) {
+      __stl_atomic_fetch_add(&queued, size_t(-1));
+      run(t);
+      return true;
+    }
+    return false;
+  }
+  void run(const task& t) {
+    t.function(t.argument);
+    if (t.group)
+      __stl_atomic_fetch_add(&t.group->pending, size_t(-1));
+    __stl_atomic_fetch_add(&outstanding, size_t(-1));
+  }
+  void wait_until_zero(const volatile size_t* count) {
+    worker* w = self();
+    __stl_backoff wait;
+    while (__stl_atomic_load(count) != 0) {
+      if (w && run_one(w, false))
+        wait.reset();
+      else
+        wait();
+    }
+  }
+
+private:
+  thread_pool(const thread_pool<Alloc>&);
+  thread_pool<Alloc>& operator=(const thread_pool<Alloc>&);
+
+public:
+  // Starts n workers, or as many of them as the system allows.
+  explicit thread_pool(size_type n);
+  ~thread_pool();
+
+  size_type size() const { return started; }
+
+  void submit(function_type f, void* arg) {
+    task t = { f, arg, 0 };
+    add(t);
+  }
+  void submit(task_group& g, function_type f, void* arg) {
+    task t = { f, arg, &g };
+    __stl_atomic_fetch_add(&g.pending, 1);
+    add(t);
+  }
+
+  void wait(const task_group& g) { wait_until_zero(&g.pending); }
+  void wait() { wait_until_zero(&outstanding); }
+};
+
+template <class Alloc>
+thread_pool<Alloc>::thread_pool(size_type n)
+  : worker_count(n), started(0), injected(injection_capacity),
+    outstanding(0), queued(0), stopping(0), sleepers(0)
+{
+  pthread_key_create(&self_key, 0);
+  pthread_mutex_init(&idle_lock, 0);
+  pthread_cond_init(&idle_cond, 0);
+  workers = worker_allocator::allocate(n);
+  for (size_type i = 0; i < n; ++i) {
+    new (workers + i) worker(deque_capacity);
+    workers[i].pool = this;
+    workers[i].index = i;
+  }
+  for ( ; started < n; ++started)
+    if (pthread_create(&workers[started].thread, 0, run_worker,
+                       workers + started) != 0)
+      break;
+}
+
+template <class Alloc>
+thread_pool<Alloc>::~thread_pool()
+{
+  wait();
+  __stl_atomic_store(&stopping, 1);
+  pthread_mutex_lock(&idle_lock);
+  pthread_cond_broadcast(&idle_cond);
+  pthread_mutex_unlock(&idle_lock);
+  for (size_type i = 0; i < started; ++i)
+    pthread_join(workers[i].thread, 0);
+  for (size_type i = 0; i < worker_count; ++i)
+    workers[i].~worker();
+  worker_allocator::deallocate(workers, worker_count);
+  pthread_cond_destroy(&idle_cond);
+  pthread_mutex_destroy(&idle_lock);
+  pthread_key_delete(self_key);
+}
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma reset woff 1174
+#endif
+
+__STL_END_NAMESPACE
+
+#endif /* __STL_PTHREADS */
+
+#endif /* __SGI_STL_INTERNAL_THREAD_POOL_H */
+
+// Local Variables:
+// mode:C++
+// End:
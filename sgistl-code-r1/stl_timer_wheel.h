@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 1997
+ * Silicon Graphics Computer Systems, Inc.
+ *
+ * Permission to use, copy, modify, distribute and sell this software
+ * and its documentation for any purpose is hereby granted without fee,
+ * provided that the above copyright notice appear in all copies and
+ * that both that copyright notice and this permission notice appear
+ * in supporting documentation.  Silicon Graphics makes no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ */
+
+/* NOTE: This is an internal header file, included by other STL headers.
+ *   You should not attempt to use it directly.
+ */
+
+#ifndef __SGI_STL_INTERNAL_TIMER_WHEEL_H
+#define __SGI_STL_INTERNAL_TIMER_WHEEL_H
+
+/*
+
+Hierarchical timing wheel: a container of timers, each a value of type
+T due at some tick, for populations large enough that the O(log n) of a
+priority_queue or multimap per timer matters.
+
+schedule() and cancel() are O(1).  advance(t) moves the clock to tick t
+and moves every timer due by then, in the order they fall due, to the
+expired list, from which they are taken with expired_front() and
+pop_expired().  A timer scheduled for now() or earlier goes straight to
+the expired list.  A handle stays valid, and its timer can be cancelled
+or rescheduled, until it is popped from the expired list or cancelled.
+
+The wheel has level_count levels of slot_count slots.  A slot of level l
+holds timers due in one span of slot_count^l ticks, a slot of level 0
+those due at one tick.  Each slot is a circular list of intrusive nodes
+allocated from Alloc.  When the clock enters the span of a higher-level
+slot its timers are redistributed to the levels below, so each timer is
+moved at most level_count times.  Timers further off than the top level
+reaches, slot_count^level_count ticks, wait in its farthest slot and
+are placed again each time it is reached.  advance() does not visit
+every tick: it skips from one tick at which a nonempty slot expires or
+is redistributed to the next.
+
+A timer_wheel cannot be copied.
+
+*/
+
+#include <stl_algobase.h>
+#include <stl_alloc.h>
+#include <stl_construct.h>
+
+__STL_BEGIN_NAMESPACE
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma set woff 1174
+#endif
+
+struct __timer_wheel_link {
+  __timer_wheel_link* next;
+  __timer_wheel_link* prev;
+
+  void init() { next = prev = this; }
+  bool empty() const { return next == this; }
+  void link_before(__timer_wheel_link* x) {
+    next = x;
+    prev = x->prev;
+    x->prev->next = this;
+    x->prev = this;
+  }
+  void unlink() {
+    prev->next = next;
+    next->prev = prev;
+  }
+  // Moves all of x's elements to the end of this list.
+  void splice(__timer_wheel_link* x) {
+    if (!x->empty()) {
+      x->next->prev = prev;
+      prev->next = x->next;
+      x->prev->next = this;
+      prev = x->prev;
+      x->init();
+    }
+  }
+};
+
+template <class T>
+struct __timer_wheel_node : public __timer_wheel_link {
+  unsigned long expires;
+  T value;
+};
+
+template <class T, class Alloc = alloc>
+class timer_wheel {
+public:
+  typedef T value_type;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef size_t size_type;
+  typedef unsigned long tick_type;
+  typedef __timer_wheel_node<T>* handle;
+
+protected:
+  enum { slot_bits = 6,
+         slot_count = 1 << slot_bits,
+         slot_mask = slot_count - 1,
+         level_count = 6 };
+
+  typedef __timer_wheel_link link;
+  typedef __timer_wheel_node<T> node;
+  typedef simple_alloc<node, Alloc> node_allocator;
+
+  tick_type tick;
+  size_type pending;            // timers in the wheel
+  size_type ready;              // timers on the expired list
+  link expired;
+  link slots[level_count][slot_count];
+
+  static unsigned int slot_of(tick_type t, int level) {
+    return (unsigned int) (t >> (slot_bits * level)) & slot_mask;
+  }
+
+  handle create_node(tick_type expires, const T& x) {
+    handle p = node_allocator::allocate();
+    __STL_TRY {
+      construct(&p->value, x);
+    }
+    __STL_UNWIND(node_allocator::deallocate(p));
+    p->expires = expires;
+    return p;
+  }
+  void destroy_node(handle p) {
+    destroy(&p->value);
+    node_allocator::deallocate(p);
+  }
+
+  // Puts p into the slot for its expiry; p must not be due before tick.
+  void place(handle p) {
+    const tick_type d = p->expires - tick;
+    int level = 0;
+    while (level < level_count - 1
+           && d >> (slot_bits * (level + 1)) != 0)
+      ++level;
+    unsigned int i;
+    if (level == level_count - 1
+        && d >> (slot_bits * level) >= tick_type(slot_count))
+      i = (slot_of(tick, level) + slot_mask) & slot_mask;
+    else
+      i = slot_of(p->expires, level);
+    p->link_before(&slots[level][i]);
+  }
+  void insert(handle p) {
+    if (p->expires <= tick) {
+      p->link_before(&expired);
+      ++ready;
+    }
+    else {
+      place(p);
+      ++pending;
+    }
+  }
+  void remove(handle p) {
+    p->unlink();
+    if (p->expires <= tick)
+      --ready;
+    else
+      --pending;
+  }
+  void cascade(int level, unsigned int i) {
+    link* head = &slots[level][i];
+    while (!head->empty()) {
+      handle p = (handle) head->next;
+      p->unlink();
+      place(p);
+    }
+  }
+  tick_type next_event() const;
+  void step();
+  void destroy_list(link* head) {
+    while (!head->empty()) {
+      handle p = (handle) head->next;
+      p->unlink();
+      destroy_node(p);
+    }
+  }
+
+private:
+  timer_wheel(const timer_wheel<T, Alloc>&);
+  timer_wheel<T, Alloc>& operator=(const timer_wheel<T, Alloc>&);
+
+public:
+  explicit timer_wheel(tick_type start = 0)
+    : tick(start), pending(0), ready(0) {
+    expired.init();
+    for (int l = 0; l < level_count; ++l)
+      for (int i = 0; i < slot_count; ++i)
+        slots[l][i].init();
+  }
+  ~timer_wheel() { clear(); }
+
+  tick_type now() const { return tick; }
+  size_type size() const { return pending + ready; }
+  bool empty() const { return size() == 0; }
+  static reference value(handle h) { return h->value; }
+  static tick_type expiry(handle h) { return h->expires; }
+
+  handle schedule(tick_type expires, const T& x) {
+    handle p = create_node(expires, x);
+    insert(p);
+    return p;
+  }
+  void cancel(handle h) {
+    remove(h);
+    destroy_node(h);
+  }
+  void reschedule(handle h, tick_type expires) {
+    remove(h);
+    h->expires = expires;
+    insert(h);
+  }
+
+  // Moves the clock forward to t, expiring every timer due by then.
+  void advance(tick_type t) {
+    while (tick < t) {
+      const tick_type next = pending != 0 ? next_event() : t;
+      if (next > t) {
+        tick = t;
+        break;
+      }
+      tick = next - 1;
+      step();
+    }
+  }
+
+  bool expired_empty() const { return ready == 0; }
+  size_type expired_size() const { return ready; }
+  handle expired_front() const { return (handle) expired.next; }
+  void pop_expired() { cancel(expired_front()); }
+
+  void clear() {
+    destroy_list(&expired);
+    for (int l = 0; l < level_count; ++l)
+      for (int i = 0; i < slot_count; ++i)
+        destroy_list(&slots[l][i]);
+    pending = ready = 0;
+  }
+};
+
+// The first tick after now() at which step() has something to do: a
+// nonempty level 0 slot expires, or a nonempty slot of a higher level is
+// redistributed.  The slots of a level behind the current one hold timers
+// for its next round, which starts when the level above moves on, so
+// that is where the search stops if it finds one; the top level simply
+// wraps around.
+template <class T, class Alloc>
+typename timer_wheel<T, Alloc>::tick_type
+timer_wheel<T, Alloc>::next_event() const
+{
+  for (int l = 0; l < level_count; ++l) {
+    const int shift = slot_bits * l;
+    const unsigned int i = slot_of(tick, l);
+    for (unsigned int j = i + 1; j < slot_count; ++j)
+      if (!slots[l][j].empty())
+        return ((tick >> shift) + (j - i)) << shift;
+    for (unsigned int j = 0; j <= i; ++j)
+      if (!slots[l][j].empty()) {
+        if (l == level_count - 1)
+          return ((tick >> shift) + (j + slot_count - i)) << shift;
+        return ((tick >> (shift + slot_bits)) + 1) << (shift + slot_bits);
+      }
+  }
+  return tick + 1;
+}
+
+// Advances the clock by one tick: at the start of a level's span the
+// matching slot of the level above is redistributed, and then the
+// timers of the new tick's level 0 slot expire.
+template <class T, class Alloc>
+void timer_wheel<T, Alloc>::step()
+{
+  ++tick;
+  for (int l = 1; l < level_count && slot_of(tick, l - 1) == 0; ++l)
+    cascade(l, slot_of(tick, l));
+  link* head = &slots[0][slot_of(tick, 0)];
+  for (link* p = head->next; p != head; p = p->next)
+    --pending, ++ready;
+  expired.splice(head);
+}
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma reset woff 1174
+#endif
+
+__STL_END_NAMESPACE
+
+#endif /* __SGI_STL_INTERNAL_TIMER_WHEEL_H */
+
+// Local Variables:
+// mode:C++
+// End:
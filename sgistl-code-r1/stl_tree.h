@@ -51,6 +51,14 @@ etc.);
 relinked into its place, rather than copied, so that the only
 iterators invalidated are those referring to the deleted node.
 
+If __STL_RB_TREE_COMPACT_NODES is defined, each node keeps its color
+in the low bit of its parent link instead of in a separate field,
+which makes every node one word smaller.  Nodes are always at least
+2-byte aligned, so that bit is otherwise unused.  Everything outside
+__rb_tree_node_base reads and writes the parent and the color through
+get_parent, set_parent, get_color and set_color, so the two layouts
+are interchangeable and neither changes the container interface.
+
 */
 
 #include <stl_algobase.h>
@@ -69,11 +77,42 @@ struct __rb_tree_node_base
   typedef __rb_tree_color_type color_type;
   typedef __rb_tree_node_base* base_ptr;
 
+#ifdef __STL_RB_TREE_COMPACT_NODES
+  size_t parent_and_color;      // parent, with the color in the low bit
+#else /* __STL_RB_TREE_COMPACT_NODES */
   color_type color; 
   base_ptr parent;
+#endif /* __STL_RB_TREE_COMPACT_NODES */
   base_ptr left;
   base_ptr right;
 
+#ifdef __STL_RB_TREE_COMPACT_NODES
+  base_ptr get_parent() const {
+    return (base_ptr) (parent_and_color & ~size_t(1));
+  }
+  void set_parent(base_ptr p) {
+    parent_and_color = size_t(p) | (parent_and_color & 1);
+  }
+  color_type get_color() const { return color_type(parent_and_color & 1); }
+  void set_color(color_type c) {
+    parent_and_color = (parent_and_color & ~size_t(1)) | size_t(c);
+  }
+  // Unlike the two above, does not read the old value, so it can be
+  // used on a freshly allocated node.
+  void set_parent_and_color(base_ptr p, color_type c) {
+    parent_and_color = size_t(p) | size_t(c);
+  }
+#else /* __STL_RB_TREE_COMPACT_NODES */
+  base_ptr get_parent() const { return parent; }
+  void set_parent(base_ptr p) { parent = p; }
+  color_type get_color() const { return color; }
+  void set_color(color_type c) { color = c; }
+  void set_parent_and_color(base_ptr p, color_type c) {
+    parent = p;
+    color = c;
+  }
+#endif /* __STL_RB_TREE_COMPACT_NODES */
+
   static base_ptr minimum(base_ptr x)
   {
     while (x->left != 0) x = x->left;
@@ -110,10 +149,10 @@ struct __rb_tree_base_iterator
         node = node->left;
     }
     else {
-      base_ptr y = node->parent;
+      base_ptr y = node->get_parent();
       while (node == y->right) {
         node = y;
-        y = y->parent;
+        y = y->get_parent();
       }
       if (node->right != y)
         node = y;
@@ -122,8 +161,8 @@ struct __rb_tree_base_iterator
 
   void decrement()
   {
-    if (node->color == __rb_tree_red &&
-        node->parent->parent == node)
+    if (node->get_color() == __rb_tree_red &&
+        node->get_parent()->get_parent() == node)
       node = node->right;
     else if (node->left != 0) {
       base_ptr y = node->left;
@@ -132,10 +171,10 @@ struct __rb_tree_base_iterator
       node = y;
     }
     else {
-      base_ptr y = node->parent;
+      base_ptr y = node->get_parent();
       while (node == y->left) {
         node = y;
-        y = y->parent;
+        y = y->get_parent();
       }
       node = y;
     }
@@ -212,17 +251,17 @@ __rb_tree_rotate_left(__rb_tree_node_base* x, __rb_tree_node_base*& root)
   __rb_tree_node_base* y = x->right;
   x->right = y->left;
   if (y->left !=0)
-    y->left->parent = x;
-  y->parent = x->parent;
+    y->left->set_parent(x);
+  y->set_parent(x->get_parent());
 
   if (x == root)
     root = y;
-  else if (x == x->parent->left)
-    x->parent->left = y;
+  else if (x == x->get_parent()->left)
+    x->get_parent()->left = y;
   else
-    x->parent->right = y;
+    x->get_parent()->right = y;
   y->left = x;
-  x->parent = y;
+  x->set_parent(y);
 }
 
 inline void 
@@ -231,62 +270,62 @@ __rb_tree_rotate_right(__rb_tree_node_base* x, __rb_tree_node_base*& root)
   __rb_tree_node_base* y = x->left;
   x->left = y->right;
   if (y->right != 0)
-    y->right->parent = x;
-  y->parent = x->parent;
+    y->right->set_parent(x);
+  y->set_parent(x->get_parent());
 
   if (x == root)
     root = y;
-  else if (x == x->parent->right)
-    x->parent->right = y;
+  else if (x == x->get_parent()->right)
+    x->get_parent()->right = y;
   else
-    x->parent->left = y;
+    x->get_parent()->left = y;
   y->right = x;
-  x->parent = y;
+  x->set_parent(y);
 }
 
 inline void 
 __rb_tree_rebalance(__rb_tree_node_base* x, __rb_tree_node_base*& root)
 {
-  x->color = __rb_tree_red;
-  while (x != root && x->parent->color == __rb_tree_red) {
-    if (x->parent == x->parent->parent->left) {
-      __rb_tree_node_base* y = x->parent->parent->right;
-      if (y && y->color == __rb_tree_red) {
-        x->parent->color = __rb_tree_black;
-        y->color = __rb_tree_black;
-        x->parent->parent->color = __rb_tree_red;
-        x = x->parent->parent;
+  x->set_color(__rb_tree_red);
+  while (x != root && x->get_parent()->get_color() == __rb_tree_red) {
+    if (x->get_parent() == x->get_parent()->get_parent()->left) {
+      __rb_tree_node_base* y = x->get_parent()->get_parent()->right;
+      if (y && y->get_color() == __rb_tree_red) {
+        x->get_parent()->set_color(__rb_tree_black);
+        y->set_color(__rb_tree_black);
+        x->get_parent()->get_parent()->set_color(__rb_tree_red);
+        x = x->get_parent()->get_parent();
       }
       else {
-        if (x == x->parent->right) {
-          x = x->parent;
+        if (x == x->get_parent()->right) {
+          x = x->get_parent();
           __rb_tree_rotate_left(x, root);
         }
-        x->parent->color = __rb_tree_black;
-        x->parent->parent->color = __rb_tree_red;
-        __rb_tree_rotate_right(x->parent->parent, root);
+        x->get_parent()->set_color(__rb_tree_black);
+        x->get_parent()->get_parent()->set_color(__rb_tree_red);
+        __rb_tree_rotate_right(x->get_parent()->get_parent(), root);
       }
     }
     else {
-      __rb_tree_node_base* y = x->parent->parent->left;
-      if (y && y->color == __rb_tree_red) {
-        x->parent->color = __rb_tree_black;
-        y->color = __rb_tree_black;
-        x->parent->parent->color = __rb_tree_red;
-        x = x->parent->parent;
+      __rb_tree_node_base* y = x->get_parent()->get_parent()->left;
+      if (y && y->get_color() == __rb_tree_red) {
+        x->get_parent()->set_color(__rb_tree_black);
+        y->set_color(__rb_tree_black);
+        x->get_parent()->get_parent()->set_color(__rb_tree_red);
+        x = x->get_parent()->get_parent();
       }
       else {
-        if (x == x->parent->left) {
-          x = x->parent;
+        if (x == x->get_parent()->left) {
+          x = x->get_parent();
           __rb_tree_rotate_right(x, root);
         }
-        x->parent->color = __rb_tree_black;
-        x->parent->parent->color = __rb_tree_red;
-        __rb_tree_rotate_left(x->parent->parent, root);
+        x->get_parent()->set_color(__rb_tree_black);
+        x->get_parent()->get_parent()->set_color(__rb_tree_red);
+        __rb_tree_rotate_left(x->get_parent()->get_parent(), root);
       }
     }
   }
-  root->color = __rb_tree_black;
+  root->set_color(__rb_tree_black);
 }
 
 inline __rb_tree_node_base*
@@ -295,6 +334,7 @@ __rb_tree_rebalance_for_erase(__rb_tree_node_base* z,
                               __rb_tree_node_base*& leftmost,
                               __rb_tree_node_base*& rightmost)
 {
+  typedef __rb_tree_color_type color_type;
   __rb_tree_node_base* y = z;
   __rb_tree_node_base* x = 0;
   __rb_tree_node_base* x_parent = 0;
@@ -310,107 +350,109 @@ __rb_tree_rebalance_for_erase(__rb_tree_node_base* z,
       x = y->right;
     }
   if (y != z) {                 // relink y in place of z.  y is z's successor
-    z->left->parent = y; 
+    z->left->set_parent(y); 
     y->left = z->left;
     if (y != z->right) {
-      x_parent = y->parent;
-      if (x) x->parent = y->parent;
-      y->parent->left = x;      // y must be a left child
+      x_parent = y->get_parent();
+      if (x) x->set_parent(y->get_parent());
+      y->get_parent()->left = x; // y must be a left child
       y->right = z->right;
-      z->right->parent = y;
+      z->right->set_parent(y);
     }
     else
       x_parent = y;  
     if (root == z)
       root = y;
-    else if (z->parent->left == z)
-      z->parent->left = y;
+    else if (z->get_parent()->left == z)
+      z->get_parent()->left = y;
     else 
-      z->parent->right = y;
-    y->parent = z->parent;
-    __STD::swap(y->color, z->color);
+      z->get_parent()->right = y;
+    y->set_parent(z->get_parent());
+    color_type c = y->get_color();
+    y->set_color(z->get_color());
+    z->set_color(c);
     y = z;
     // y now points to node to be actually deleted
   }
   else {                        // y == z
-    x_parent = y->parent;
-    if (x) x->parent = y->parent;   
+    x_parent = y->get_parent();
+    if (x) x->set_parent(y->get_parent());   
     if (root == z)
       root = x;
     else 
-      if (z->parent->left == z)
-        z->parent->left = x;
+      if (z->get_parent()->left == z)
+        z->get_parent()->left = x;
       else
-        z->parent->right = x;
+        z->get_parent()->right = x;
     if (leftmost == z) 
       if (z->right == 0)        // z->left must be null also
-        leftmost = z->parent;
+        leftmost = z->get_parent();
     // makes leftmost == header if z == root
       else
         leftmost = __rb_tree_node_base::minimum(x);
     if (rightmost == z)  
       if (z->left == 0)         // z->right must be null also
-        rightmost = z->parent;  
+        rightmost = z->get_parent();  
     // makes rightmost == header if z == root
       else                      // x == z->left
         rightmost = __rb_tree_node_base::maximum(x);
   }
-  if (y->color != __rb_tree_red) { 
-    while (x != root && (x == 0 || x->color == __rb_tree_black))
+  if (y->get_color() != __rb_tree_red) { 
+    while (x != root && (x == 0 || x->get_color() == __rb_tree_black))
       if (x == x_parent->left) {
         __rb_tree_node_base* w = x_parent->right;
-        if (w->color == __rb_tree_red) {
-          w->color = __rb_tree_black;
-          x_parent->color = __rb_tree_red;
+        if (w->get_color() == __rb_tree_red) {
+          w->set_color(__rb_tree_black);
+          x_parent->set_color(__rb_tree_red);
           __rb_tree_rotate_left(x_parent, root);
           w = x_parent->right;
         }
-        if ((w->left == 0 || w->left->color == __rb_tree_black) &&
-            (w->right == 0 || w->right->color == __rb_tree_black)) {
-          w->color = __rb_tree_red;
+        if ((w->left == 0 || w->left->get_color() == __rb_tree_black) &&
+            (w->right == 0 || w->right->get_color() == __rb_tree_black)) {
+          w->set_color(__rb_tree_red);
           x = x_parent;
-          x_parent = x_parent->parent;
+          x_parent = x_parent->get_parent();
         } else {
-          if (w->right == 0 || w->right->color == __rb_tree_black) {
-            if (w->left) w->left->color = __rb_tree_black;
-            w->color = __rb_tree_red;
+          if (w->right == 0 || w->right->get_color() == __rb_tree_black) {
+            if (w->left) w->left->set_color(__rb_tree_black);
+            w->set_color(__rb_tree_red);
             __rb_tree_rotate_right(w, root);
             w = x_parent->right;
           }
-          w->color = x_parent->color;
-          x_parent->color = __rb_tree_black;
-          if (w->right) w->right->color = __rb_tree_black;
+          w->set_color(x_parent->get_color());
+          x_parent->set_color(__rb_tree_black);
+          if (w->right) w->right->set_color(__rb_tree_black);
           __rb_tree_rotate_left(x_parent, root);
           break;
         }
       } else {                  // same as above, with right <-> left.
         __rb_tree_node_base* w = x_parent->left;
-        if (w->color == __rb_tree_red) {
-          w->color = __rb_tree_black;
-          x_parent->color = __rb_tree_red;
+        if (w->get_color() == __rb_tree_red) {
+          w->set_color(__rb_tree_black);
+          x_parent->set_color(__rb_tree_red);
           __rb_tree_rotate_right(x_parent, root);
           w = x_parent->left;
         }
-        if ((w->right == 0 || w->right->color == __rb_tree_black) &&
-            (w->left == 0 || w->left->color == __rb_tree_black)) {
-          w->color = __rb_tree_red;
+        if ((w->right == 0 || w->right->get_color() == __rb_tree_black) &&
+            (w->left == 0 || w->left->get_color() == __rb_tree_black)) {
+          w->set_color(__rb_tree_red);
           x = x_parent;
-          x_parent = x_parent->parent;
+          x_parent = x_parent->get_parent();
         } else {
-          if (w->left == 0 || w->left->color == __rb_tree_black) {
-            if (w->right) w->right->color = __rb_tree_black;
-            w->color = __rb_tree_red;
+          if (w->left == 0 || w->left->get_color() == __rb_tree_black) {
+            if (w->right) w->right->set_color(__rb_tree_black);
+            w->set_color(__rb_tree_red);
             __rb_tree_rotate_left(w, root);
             w = x_parent->left;
           }
-          w->color = x_parent->color;
-          x_parent->color = __rb_tree_black;
-          if (w->left) w->left->color = __rb_tree_black;
+          w->set_color(x_parent->get_color());
+          x_parent->set_color(__rb_tree_black);
+          if (w->left) w->left->set_color(__rb_tree_black);
           __rb_tree_rotate_right(x_parent, root);
           break;
         }
       }
-    if (x) x->color = __rb_tree_black;
+    if (x) x->set_color(__rb_tree_black);
   }
   return y;
 }
@@ -444,12 +486,13 @@ protected:
       construct(&tmp->value_field, x);
     }
     __STL_UNWIND(put_node(tmp));
+    tmp->set_parent_and_color(0, __rb_tree_red);
     return tmp;
   }
 
   link_type clone_node(link_type x) {
     link_type tmp = create_node(x->value_field);
-    tmp->color = x->color;
+    tmp->set_color(x->get_color());
     tmp->left = 0;
     tmp->right = 0;
     return tmp;
@@ -465,23 +508,24 @@ protected:
   link_type header;  
   Compare key_compare;
 
-  link_type& root() const { return (link_type&) header->parent; }
+  link_type root() const { return (link_type) header->get_parent(); }
+  void set_root(base_ptr x) const { header->set_parent(x); }
   link_type& leftmost() const { return (link_type&) header->left; }
   link_type& rightmost() const { return (link_type&) header->right; }
 
   static link_type& left(link_type x) { return (link_type&)(x->left); }
   static link_type& right(link_type x) { return (link_type&)(x->right); }
-  static link_type& parent(link_type x) { return (link_type&)(x->parent); }
+  static link_type parent(link_type x) { return (link_type)(x->get_parent()); }
   static reference value(link_type x) { return x->value_field; }
   static const Key& key(link_type x) { return KeyOfValue()(value(x)); }
-  static color_type& color(link_type x) { return (color_type&)(x->color); }
+  static color_type color(link_type x) { return x->get_color(); }
 
   static link_type& left(base_ptr x) { return (link_type&)(x->left); }
   static link_type& right(base_ptr x) { return (link_type&)(x->right); }
-  static link_type& parent(base_ptr x) { return (link_type&)(x->parent); }
+  static link_type parent(base_ptr x) { return (link_type)(x->get_parent()); }
   static reference value(base_ptr x) { return ((link_type)x)->value_field; }
   static const Key& key(base_ptr x) { return KeyOfValue()(value(link_type(x)));} 
-  static color_type& color(base_ptr x) { return (color_type&)(link_type(x)->color); }
+  static color_type color(base_ptr x) { return x->get_color(); }
 
   static link_type minimum(link_type x) { 
     return (link_type)  __rb_tree_node_base::minimum(x);
@@ -508,13 +552,13 @@ public:
 #endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */ 
 private:
   iterator __insert(base_ptr x, base_ptr y, const value_type& v);
+  iterator __insert_rightmost(const value_type& v);
   link_type __copy(link_type x, link_type p);
   void __erase(link_type x);
   void init() {
     header = get_node();
-    color(header) = __rb_tree_red; // used to distinguish header from 
-                                   // root, in iterator.operator++
-    root() = 0;
+    // red is used to distinguish header from root, in iterator.operator++
+    header->set_parent_and_color(0, __rb_tree_red);
     leftmost() = header;
     rightmost() = header;
   }
@@ -527,15 +571,14 @@ public:
     : node_count(0), key_compare(x.key_compare)
   { 
     header = get_node();
-    color(header) = __rb_tree_red;
+    header->set_parent_and_color(0, __rb_tree_red);
     if (x.root() == 0) {
-      root() = 0;
       leftmost() = header;
       rightmost() = header;
     }
     else {
       __STL_TRY {
-        root() = __copy(x.root(), header);
+        set_root(__copy(x.root(), header));
       }
       __STL_UNWIND(put_node(header));
       leftmost() = minimum(root());
@@ -595,6 +638,25 @@ public:
   void insert_equal(const value_type* first, const value_type* last);
 #endif /* __STL_MEMBER_TEMPLATES */
 
+                                // append: O(1) amortized when v is not
+                                // less than (append_equal) or is greater
+                                // than (append_unique) the current maximum,
+                                // otherwise an ordinary insert.
+  iterator append_unique(const value_type& v);
+  iterator append_equal(const value_type& v);
+
+#ifdef __STL_MEMBER_TEMPLATES  
+  template <class InputIterator>
+  void append_unique(InputIterator first, InputIterator last);
+  template <class InputIterator>
+  void append_equal(InputIterator first, InputIterator last);
+#else /* __STL_MEMBER_TEMPLATES */
+  void append_unique(const_iterator first, const_iterator last);
+  void append_unique(const value_type* first, const value_type* last);
+  void append_equal(const_iterator first, const_iterator last);
+  void append_equal(const value_type* first, const value_type* last);
+#endif /* __STL_MEMBER_TEMPLATES */
+
   void erase(iterator position);
   size_type erase(const key_type& x);
   void erase(iterator first, iterator last);
@@ -603,7 +665,7 @@ public:
     if (node_count != 0) {
       __erase(root());
       leftmost() = header;
-      root() = 0;
+      set_root(0);
       rightmost() = header;
       node_count = 0;
     }
@@ -659,12 +721,12 @@ operator=(const rb_tree<Key, Value, KeyOfValue, Compare, Alloc>& x) {
     node_count = 0;
     key_compare = x.key_compare;        
     if (x.root() == 0) {
-      root() = 0;
+      set_root(0);
       leftmost() = header;
       rightmost() = header;
     }
     else {
-      root() = __copy(x.root(), header);
+      set_root(__copy(x.root(), header));
       leftmost() = minimum(root());
       rightmost() = maximum(root());
       node_count = x.node_count;
@@ -685,7 +747,7 @@ __insert(base_ptr x_, base_ptr y_, const Value& v) {
     z = create_node(v);
     left(y) = z;                // also makes leftmost() = z when y == header
     if (y == header) {
-      root() = z;
+      set_root(z);
       rightmost() = z;
     }
     else if (y == leftmost())
@@ -697,10 +759,38 @@ __insert(base_ptr x_, base_ptr y_, const Value& v) {
     if (y == rightmost())
       rightmost() = z;          // maintain rightmost() pointing to max node
   }
-  parent(z) = y;
+  z->set_parent(y);
+  left(z) = 0;
+  right(z) = 0;
+  base_ptr r = root();
+  __rb_tree_rebalance(z, r);
+  set_root(r);
+  ++node_count;
+  return iterator(z);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::
+__insert_rightmost(const Value& v) {
+                                // caller has already established that v
+                                // belongs after rightmost(); link it there
+                                // without comparing again.
+  link_type y = rightmost();
+  link_type z = create_node(v);
+  if (y == header) {
+    left(y) = z;                // makes leftmost() = z
+    set_root(z);
+  }
+  else
+    right(y) = z;
+  rightmost() = z;
+  z->set_parent(y);
   left(z) = 0;
   right(z) = 0;
-  __rb_tree_rebalance(z, header->parent);
+  base_ptr r = root();
+  __rb_tree_rebalance(z, r);
+  set_root(r);
   ++node_count;
   return iterator(z);
 }
@@ -747,22 +837,19 @@ template <class Key, class Val, class KeyOfValue, class Compare, class Alloc>
 typename rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::iterator 
 rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::insert_unique(iterator position,
                                                              const Val& v) {
-  if (position.node == header->left) // begin()
-    if (size() > 0 && key_compare(KeyOfValue()(v), key(position.node)))
-      return __insert(position.node, position.node, v);
-  // first argument just needs to be non-null 
-    else
-      return insert_unique(v).first;
-  else if (position.node == header) // end()
-    if (key_compare(key(rightmost()), KeyOfValue()(v)))
-      return __insert(0, rightmost(), v);
+  if (position.node == header) // end()
+    if (size() > 0 && key_compare(key(rightmost()), KeyOfValue()(v)))
+      return __insert_rightmost(v);
     else
       return insert_unique(v).first;
-  else {
+  else if (key_compare(KeyOfValue()(v), key(position.node))) {
+    // v belongs before position: check the predecessor.
+    if (position.node == header->left) // begin()
+      return __insert(position.node, position.node, v);
+    // first argument just needs to be non-null 
     iterator before = position;
     --before;
-    if (key_compare(key(before.node), KeyOfValue()(v))
-        && key_compare(KeyOfValue()(v), key(position.node)))
+    if (key_compare(key(before.node), KeyOfValue()(v)))
       if (right(before.node) == 0)
         return __insert(0, before.node, v); 
       else
@@ -771,6 +858,23 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::insert_unique(iterator position,
     else
       return insert_unique(v).first;
   }
+  else if (key_compare(key(position.node), KeyOfValue()(v))) {
+    // v belongs after position: check the successor.
+    if (position.node == header->right) // rightmost()
+      return __insert_rightmost(v);
+    iterator after = position;
+    ++after;
+    if (key_compare(KeyOfValue()(v), key(after.node)))
+      if (right(position.node) == 0)
+        return __insert(0, position.node, v);
+      else
+        return __insert(after.node, after.node, v);
+    // first argument just needs to be non-null 
+    else
+      return insert_unique(v).first;
+  }
+  else
+    return position;            // equivalent key already present
 }
 
 template <class Key, class Val, class KeyOfValue, class Compare, class Alloc>
@@ -785,7 +889,7 @@ rb_tree<Key, Val, KeyOfValue, Compare, Alloc>::insert_equal(iterator position,
       return insert_equal(v);
   else if (position.node == header) // end()
     if (!key_compare(KeyOfValue()(v), key(rightmost())))
-      return __insert(0, rightmost(), v);
+      return __insert_rightmost(v);
     else
       return insert_equal(v);
   else {
@@ -849,15 +953,82 @@ rb_tree<K, V, KoV, Cmp, A>::insert_unique(const_iterator first,
     insert_unique(*first);
 }
 
+#endif /* __STL_MEMBER_TEMPLATES */
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+inline typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::append_unique(const Value& v) {
+  if (node_count == 0 || key_compare(key(rightmost()), KeyOfValue()(v)))
+    return __insert_rightmost(v);
+  else
+    return insert_unique(v).first;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+inline typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::append_equal(const Value& v) {
+  if (node_count == 0 || !key_compare(KeyOfValue()(v), key(rightmost())))
+    return __insert_rightmost(v);
+  else
+    return insert_equal(v);
+}
+
+#ifdef __STL_MEMBER_TEMPLATES  
+
+template <class K, class V, class KoV, class Cmp, class Al> template<class II>
+void rb_tree<K, V, KoV, Cmp, Al>::append_equal(II first, II last) {
+  for ( ; first != last; ++first)
+    append_equal(*first);
+}
+
+template <class K, class V, class KoV, class Cmp, class Al> template<class II>
+void rb_tree<K, V, KoV, Cmp, Al>::append_unique(II first, II last) {
+  for ( ; first != last; ++first)
+    append_unique(*first);
+}
+
+#else /* __STL_MEMBER_TEMPLATES */
+
+template <class K, class V, class KoV, class Cmp, class Al>
+void
+rb_tree<K, V, KoV, Cmp, Al>::append_equal(const V* first, const V* last) {
+  for ( ; first != last; ++first)
+    append_equal(*first);
+}
+
+template <class K, class V, class KoV, class Cmp, class Al>
+void
+rb_tree<K, V, KoV, Cmp, Al>::append_equal(const_iterator first,
+                                          const_iterator last) {
+  for ( ; first != last; ++first)
+    append_equal(*first);
+}
+
+template <class K, class V, class KoV, class Cmp, class A>
+void 
+rb_tree<K, V, KoV, Cmp, A>::append_unique(const V* first, const V* last) {
+  for ( ; first != last; ++first)
+    append_unique(*first);
+}
+
+template <class K, class V, class KoV, class Cmp, class A>
+void 
+rb_tree<K, V, KoV, Cmp, A>::append_unique(const_iterator first,
+                                          const_iterator last) {
+  for ( ; first != last; ++first)
+    append_unique(*first);
+}
+
 #endif /* __STL_MEMBER_TEMPLATES */
          
 template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
 inline void
 rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::erase(iterator position) {
-  link_type y = (link_type) __rb_tree_rebalance_for_erase(position.node,
-                                                          header->parent,
+  base_ptr r = root();
+  link_type y = (link_type) __rb_tree_rebalance_for_erase(position.node, r,
                                                           header->left,
                                                           header->right);
+  set_root(r);
   destroy_node(y);
   --node_count;
 }
@@ -877,7 +1048,7 @@ typename rb_tree<K, V, KeyOfValue, Compare, Alloc>::link_type
 rb_tree<K, V, KeyOfValue, Compare, Alloc>::__copy(link_type x, link_type p) {
                                 // structural copy.  x and p must be non-null.
   link_type top = clone_node(x);
-  top->parent = p;
+  top->set_parent(p);
  
   __STL_TRY {
     if (x->right)
@@ -888,7 +1059,7 @@ rb_tree<K, V, KeyOfValue, Compare, Alloc>::__copy(link_type x, link_type p) {
     while (x != 0) {
       link_type y = clone_node(x);
       p->left = y;
-      y->parent = p;
+      y->set_parent(p);
       if (x->right)
         y->right = __copy(right(x), y);
       p = y;
@@ -1046,11 +1217,11 @@ inline int __black_count(__rb_tree_node_base* node, __rb_tree_node_base* root)
   if (node == 0)
     return 0;
   else {
-    int bc = node->color == __rb_tree_black ? 1 : 0;
+    int bc = node->get_color() == __rb_tree_black ? 1 : 0;
     if (node == root)
       return bc;
     else
-      return bc + __black_count(node->parent, root);
+      return bc + __black_count(node->get_parent(), root);
   }
 }
 
@@ -1068,9 +1239,9 @@ rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::__rb_verify() const
     link_type L = left(x);
     link_type R = right(x);
 
-    if (x->color == __rb_tree_red)
-      if ((L && L->color == __rb_tree_red) ||
-          (R && R->color == __rb_tree_red))
+    if (x->get_color() == __rb_tree_red)
+      if ((L && L->get_color() == __rb_tree_red) ||
+          (R && R->get_color() == __rb_tree_red))
         return false;
 
     if (L && key_compare(key(x), key(L)))
@@ -80,6 +80,29 @@ __uninitialized_copy_aux(InputIterator first, InputIterator last,
   __STL_UNWIND(destroy(result, cur));
 }
 
+#ifdef __STL_FUNCTION_TMPL_PARTIAL_ORDER
+
+// Uninitialized storage cannot overlap the source, so PODs in contiguous
+// memory are copied with memcpy rather than copy's memmove.
+template <class T>
+inline T* __uninitialized_copy_aux(const T* first, const T* last, T* result,
+                                   __true_type)
+{
+  if (first != last)
+    memcpy(result, first, sizeof(T) * (last - first));
+  return result + (last - first);
+}
+
+template <class T>
+inline T* __uninitialized_copy_aux(T* first, T* last, T* result, __true_type)
+{
+  if (first != last)
+    memcpy(result, first, sizeof(T) * (last - first));
+  return result + (last - first);
+}
+
+#endif /* __STL_FUNCTION_TMPL_PARTIAL_ORDER */
+
 //char*wchar_t*ػ汾ʹЧʸߵmemmove
 inline char* uninitialized_copy(const char* first, const char* last,
                                 char* result) 
@@ -221,6 +244,44 @@ __uninitialized_fill_n_aux(ForwardIterator first, Size n,
   __STL_UNWIND(destroy(first, cur));
 }
 
+// Default-initializes n objects at first; see default_init_t.
+template <class ForwardIterator, class Size>
+inline ForwardIterator
+__uninitialized_default_n_aux(ForwardIterator first, Size n, __true_type)
+{
+  advance(first, n);
+  return first;
+}
+
+template <class ForwardIterator, class Size>
+ForwardIterator
+__uninitialized_default_n_aux(ForwardIterator first, Size n, __false_type)
+{
+  ForwardIterator cur = first;
+  __STL_TRY 
+  {
+    for ( ; n > 0; --n, ++cur)
+      construct(&*cur);
+    return cur;
+  }
+  __STL_UNWIND(destroy(first, cur));
+}
+
+template <class ForwardIterator, class Size, class T>
+inline ForwardIterator
+__uninitialized_default_n(ForwardIterator first, Size n, T*)
+{
+  typedef typename __type_traits<T>::has_trivial_default_constructor trivial;
+  return __uninitialized_default_n_aux(first, n, trivial());
+}
+
+template <class ForwardIterator, class Size>
+inline ForwardIterator
+__uninitialized_default_n(ForwardIterator first, Size n)
+{
+  return __uninitialized_default_n(first, n, value_type(first));
+}
+
 // Copies [first1, last1) into [result, result + (last1 - first1)), and
 //  copies [first2, last2) into
 //  [result, result + (last1 - first1) + (last2 - first2)).
@@ -17,9 +17,234 @@ __STL_BEGIN_NAMESPACE
 *  copy/copy_backward
 */
 
+// Growth policies, for vector's third template parameter.  capacity()
+// maps the current size, the number of elements being added and the
+// element size to the capacity to allocate, at least old_size + n.
+
+// Doubling: the fewest reallocations, but up to half the block unused.
+struct vector_growth_2x {
+  static size_t capacity(size_t old_size, size_t n, size_t) {
+    return old_size + max(old_size, n);
+  }
+};
+
+// Growing by half wastes at most a third of the block, and the blocks
+// freed along the way can eventually be reused for a larger one.
+struct vector_growth_1_5x {
+  static size_t capacity(size_t old_size, size_t n, size_t) {
+    return old_size + max(old_size / 2, n);
+  }
+};
+
+// Grows by half, then sizes blocks of a page or more so that, with the
+// header malloc puts in front of a block (taken to be two words), they
+// end on a page boundary rather than spilling a few bytes into the next
+// page.
+struct vector_growth_page {
+  enum { page_size = 4096 };
+  static size_t capacity(size_t old_size, size_t n, size_t elem_size) {
+    const size_t len = old_size + max(old_size / 2, n);
+    const size_t header = 2 * sizeof(void*);
+    const size_t bytes = len * elem_size + header;
+    if (bytes < (size_t) page_size)
+      return len;
+    const size_t pages = (bytes + page_size - 1) / page_size;
+    return (pages * page_size - header) / elem_size;
+  }
+};
+
+// Grows by half, then takes as many elements as the block Alloc will
+// return can hold, as __usable_size_traits<Alloc> reports it.  For alloc
+// that fills out the free-list size class of a small block; for larger
+// blocks, and for allocators it knows nothing about, it changes nothing.
+template <class Alloc = alloc>
+struct vector_growth_usable {
+  static size_t capacity(size_t old_size, size_t n, size_t elem_size) {
+    const size_t len = old_size + max(old_size / 2, n);
+    return __usable_size_traits<Alloc>::usable(len * elem_size) / elem_size;
+  }
+};
+
+#ifdef __STL_VECTOR_STATS
+// With __STL_VECTOR_STATS defined, each vector type counts its
+// reallocations and the bytes of elements they moved, in
+// vector<...>::stats().  The counters are not synchronized.
+struct vector_stats {
+  size_t reallocations;
+  size_t bytes_moved;
+};
+#endif /* __STL_VECTOR_STATS */
+
+// The work vector does on the elements inside a block, shared with
+// small_vector.  The elements are [start, finish), and finish is moved
+// along in place.  The __true_type overloads are for trivially
+// relocatable T and shift elements with memmove; the insertions assume
+// the block already has room for the new elements.
+
+// Moves the elements into the storage at new_start, leaving a gap of n
+// raw elements at position, and returns the new finish.  [start,
+// finish) is raw storage afterwards.  If an exception is thrown, nothing
+// has changed and nothing is left constructed at new_start.
+template <class T>
+T* __vector_relocate_around(T* start, T* finish, T* position,
+                            T* new_start, size_t n, __true_type) {
+  const size_t elems_before = position - start;
+  const size_t elems_after = finish - position;
+  if (start != 0) {
+    memcpy((void*) new_start, (const void*) start, elems_before * sizeof(T));
+    memcpy((void*) (new_start + elems_before + n), (const void*) position,
+           elems_after * sizeof(T));
+  }
+  return new_start + elems_before + n + elems_after;
+}
+
+template <class T>
+T* __vector_relocate_around(T* start, T* finish, T* position,
+                            T* new_start, size_t n, __false_type) {
+  T* mid = uninitialized_copy(start, position, new_start);
+  T* new_finish = mid;
+  __STL_TRY {
+    new_finish = uninitialized_copy(position, finish, mid + n);
+  }
+  __STL_UNWIND(destroy(new_start, mid));
+  destroy(start, finish);
+  return new_finish;
+}
+
+// For trivially relocatable T only: __vector_open_gap shifts [position,
+// finish) up by n, leaving [position, position + n) as raw storage, and
+// __vector_close_gap shifts it back down over such a gap.
+template <class T>
+inline void __vector_open_gap(T* position, T*& finish, size_t n) {
+  memmove((void*) (position + n), (const void*) position,
+          (finish - position) * sizeof(T));
+  finish += n;
+}
+
+template <class T>
+inline void __vector_close_gap(T* position, T*& finish, size_t n) {
+  finish -= n;
+  if (finish != position)
+    memmove((void*) position, (const void*) (position + n),
+            (finish - position) * sizeof(T));
+}
+
+template <class T>
+inline T* __vector_erase(T* first, T* last, T*& finish, __true_type) {
+  destroy(first, last);
+  __vector_close_gap(first, finish, last - first);
+  return first;
+}
+
+template <class T>
+inline T* __vector_erase(T* first, T* last, T*& finish, __false_type) {
+  T* i = copy(last, finish, first);
+
+  //ԪصtrivialģʲôҲ
+  //Ԫصnon-trivialģ
+  destroy(i, finish);
+
+  finish = finish - (last - first);	//µfinish
+
+  return first;
+}
+
+// Inserts x before position.
+template <class T>
+void __vector_insert(T* position, T*& finish, const T& x, __true_type) {
+  const T* p = &x;
+  if (p >= position && p < finish)  // x is one of the elements to shift
+    ++p;
+  __vector_open_gap(position, finish, 1);
+  __STL_TRY {
+    construct(position, *p);
+  }
+  __STL_UNWIND(__vector_close_gap(position, finish, 1));
+}
+
+template <class T>
+void __vector_insert(T* position, T*& finish, const T& x, __false_type) {
+  construct(finish, *(finish - 1));
+  ++finish;
+  T x_copy = x;
+  copy_backward(position, finish - 2, finish - 1);
+  *position = x_copy;
+}
+
+// Inserts n copies of x before position.
+template <class T>
+void __vector_fill_insert(T* position, T*& finish, size_t n, const T& x,
+                          __true_type) {
+  const T* p = &x;
+  if (p >= position && p < finish)  // x is one of the elements to shift
+    p += n;
+  __vector_open_gap(position, finish, n);
+  __STL_TRY {
+    uninitialized_fill_n(position, n, *p);
+  }
+  __STL_UNWIND(__vector_close_gap(position, finish, n));
+}
+
+template <class T>
+void __vector_fill_insert(T* position, T*& finish, size_t n, const T& x,
+                          __false_type) {
+  T x_copy = x;
+  const size_t elems_after = finish - position;
+  T* old_finish = finish;
+  if (elems_after > n) {
+    uninitialized_copy(finish - n, finish, finish);
+    finish += n;
+    copy_backward(position, old_finish - n, old_finish);
+    fill(position, position + n, x_copy);
+  }
+  else {
+    uninitialized_fill_n(finish, n - elems_after, x_copy);
+    finish += n - elems_after;
+    uninitialized_copy(position, old_finish, finish);
+    finish += elems_after;
+    fill(position, old_finish, x_copy);
+  }
+}
+
+// Inserts [first, last), which holds n elements, before position.
+template <class T, class ForwardIterator>
+void __vector_range_insert(T* position, T*& finish,
+                           ForwardIterator first, ForwardIterator last,
+                           size_t n, __true_type) {
+  __vector_open_gap(position, finish, n);
+  __STL_TRY {
+    uninitialized_copy(first, last, position);
+  }
+  __STL_UNWIND(__vector_close_gap(position, finish, n));
+}
+
+template <class T, class ForwardIterator>
+void __vector_range_insert(T* position, T*& finish,
+                           ForwardIterator first, ForwardIterator last,
+                           size_t n, __false_type) {
+  const size_t elems_after = finish - position;
+  T* old_finish = finish;
+  if (elems_after > n) {
+    uninitialized_copy(finish - n, finish, finish);
+    finish += n;
+    copy_backward(position, old_finish - n, old_finish);
+    copy(first, last, position);
+  }
+  else {
+    ForwardIterator mid = first;
+    advance(mid, elems_after);
+    uninitialized_copy(mid, last, finish);
+    finish += n - elems_after;
+    uninitialized_copy(position, old_finish, finish);
+    finish += elems_after;
+    copy(first, mid, position);
+  }
+}
+
 //ģβTΪ洢Ԫص
 //AllocΪڴ
-template <class T, class Alloc = alloc>
+//Growth·ʱ
+template <class T, class Alloc = alloc, class Growth = vector_growth_2x>
 class vector {
 public:
   typedef T value_type;
@@ -44,6 +269,10 @@ public:
 
 protected:
   typedef simple_alloc<value_type, Alloc> data_allocator;	//ڴ
+  typedef typename __relocate_traits<T>::is_trivially_relocatable
+          relocatable;
+  typedef typename __reallocate_traits<Alloc>::has_reallocate
+          alloc_reallocates;
   
   iterator start;	//ָڵĵһԪ
   iterator finish;	//ָһԪصĺһλ
@@ -57,6 +286,20 @@ protected:
 		data_allocator::deallocate(start, end_of_storage - start);
   }
 
+  size_type next_capacity(size_type n) const {
+    return Growth::capacity(size(), n, sizeof(T));
+  }
+  // Called when the elements are about to be moved out of the current
+  // block into a new one.
+  void count_reallocation() {
+#ifdef __STL_VECTOR_STATS
+    if (size() != 0) {
+      ++stats().reallocations;
+      stats().bytes_moved += size() * sizeof(T);
+    }
+#endif /* __STL_VECTOR_STATS */
+  }
+
   void fill_initialize(size_type n, const T& value) 
   {
     start = allocate_and_fill(n, value);
@@ -163,8 +406,19 @@ public:
   	fill_initialize(n, T()); 
   }
 
+  // n default-initialized elements; see default_init_t.
+  vector(size_type n, default_init_t)
+  {
+    start = data_allocator::allocate(n);
+    __STL_TRY {
+      finish = __uninitialized_default_n(start, n);
+    }
+    __STL_UNWIND(data_allocator::deallocate(start, n));
+    end_of_storage = finish;
+  }
+
   //copy ctor
-  vector(const vector<T, Alloc>& x) 
+  vector(const vector<T, Alloc, Growth>& x) 
   {
     start = allocate_and_copy(x.end() - x.begin(), x.begin(), x.end());
     finish = start + (x.end() - x.begin());
@@ -201,18 +455,32 @@ public:
     deallocate();
   }
 
-  vector<T, Alloc>& operator=(const vector<T, Alloc>& x);
+  vector<T, Alloc, Growth>& operator=(const vector<T, Alloc, Growth>& x);
+
+#ifdef __STL_VECTOR_STATS
+  static vector_stats& stats() {
+    static vector_stats s;
+    return s;
+  }
+#endif /* __STL_VECTOR_STATS */
   
   void reserve(size_type n) 
   {
     if (capacity() < n) 
 	{
-      const size_type old_size = size();
-      iterator tmp = allocate_and_copy(n, start, finish);
-      destroy(start, finish);
+      const T* none = 0;
+      if (reallocate_storage(n, none))
+        return;
+      iterator tmp = data_allocator::allocate(n);
+      iterator tmp_finish = tmp;
+      __STL_TRY {
+        tmp_finish = relocate_around(finish, tmp, 0);
+      }
+      __STL_UNWIND(data_allocator::deallocate(tmp, n));
+      count_reallocation();
       deallocate();
       start = tmp;
-      finish = tmp + old_size;
+      finish = tmp_finish;
       end_of_storage = start + n;
     }
   }
@@ -247,7 +515,7 @@ public:
       insert_aux(end(), x);
   }
   
-  void swap(vector<T, Alloc>& x) 
+  void swap(vector<T, Alloc, Growth>& x) 
   {
     __STD::swap(start, x.start);
     __STD::swap(finish, x.finish);
@@ -305,30 +573,13 @@ public:
   
   iterator erase(iterator position) 
   {
-    //ƳĲһԪ
-    if (position + 1 != end())
-	  //ƳԪ֮Ԫǰһλ
-      copy(position + 1, finish, position);
-
-	
-    --finish;
-    destroy(finish);
-	
-    return position;
+    return __vector_erase(position, position + 1, finish, relocatable());
   }
 
   //Ƴ뿪[first, last)֮ԪأlastָԪزƳ
   iterator erase(iterator first, iterator last) 
   {
-    iterator i = copy(last, finish, first);
-
-	//ԪصtrivialģʲôҲ
-	//Ԫصnon-trivialģ
-	destroy(i, finish);	
-	
-    finish = finish - (last - first);	//µfinish
-	
-    return first;
+    return __vector_erase(first, last, finish, relocatable());
   }
   
   void resize(size_type new_size, const T& x) 
@@ -345,6 +596,19 @@ public:
   	resize(new_size, T()); 
   }
 
+  // Like resize(new_size), but new elements are only default-initialized.
+  void resize_default_init(size_type new_size)
+  {
+    if (new_size < size())
+      erase(begin() + new_size, end());
+    else {
+      const size_type n = new_size - size();
+      if (size_type(end_of_storage - finish) < n)
+        reserve(next_capacity(n));
+      finish = __uninitialized_default_n(finish, n);
+    }
+  }
+
   //ڵԪ
   //size()Ϊ0capacity()
   void clear() 
@@ -389,6 +653,34 @@ protected:
 #endif /* __STL_MEMBER_TEMPLATES */
 
 
+  // See __vector_relocate_around.
+  iterator relocate_around(iterator position, iterator new_start,
+                           size_type n) {
+    return __vector_relocate_around(start, finish, position, new_start, n,
+                                    relocatable());
+  }
+
+  // If the elements are trivially relocatable and Alloc has reallocate,
+  // resizes the storage to len elements with Alloc::reallocate, which
+  // can often extend the block in place, and returns true.  p is moved
+  // along if it pointed at an element.  Otherwise returns false and
+  // changes nothing.  If the allocator cannot extend the block, the
+  // vector is left as it was and bad_alloc is thrown.
+  bool reallocate_storage(size_type len, const T*& p) {
+    return reallocate_storage(len, p, relocatable(), alloc_reallocates());
+  }
+  bool reallocate_storage(size_type len, const T*& p,
+                          __true_type, __true_type);
+  bool reallocate_storage(size_type, const T*&, __true_type, __false_type) {
+    return false;
+  }
+  bool reallocate_storage(size_type, const T*&, __false_type, __true_type) {
+    return false;
+  }
+  bool reallocate_storage(size_type, const T*&, __false_type, __false_type) {
+    return false;
+  }
+
 #ifdef __STL_MEMBER_TEMPLATES
   template <class InputIterator>
   void range_initialize(InputIterator first, InputIterator last,
@@ -424,27 +716,30 @@ protected:
 
 //1: Ԫظ
 //2: ӦԪֵ
-template <class T, class Alloc>
-inline bool operator==(const vector<T, Alloc>& x, const vector<T, Alloc>& y) {
+template <class T, class Alloc, class Growth>
+inline bool operator==(const vector<T, Alloc, Growth>& x,
+                       const vector<T, Alloc, Growth>& y) {
   return x.size() == y.size() && equal(x.begin(), x.end(), y.begin());
 }
 
-template <class T, class Alloc>
-inline bool operator<(const vector<T, Alloc>& x, const vector<T, Alloc>& y) {
+template <class T, class Alloc, class Growth>
+inline bool operator<(const vector<T, Alloc, Growth>& x,
+                      const vector<T, Alloc, Growth>& y) {
   return lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
 }
 
 #ifdef __STL_FUNCTION_TMPL_PARTIAL_ORDER
 
-template <class T, class Alloc>
-inline void swap(vector<T, Alloc>& x, vector<T, Alloc>& y) {
+template <class T, class Alloc, class Growth>
+inline void swap(vector<T, Alloc, Growth>& x, vector<T, Alloc, Growth>& y) {
   x.swap(y);
 }
 
 #endif /* __STL_FUNCTION_TMPL_PARTIAL_ORDER */
 
-template <class T, class Alloc>
-vector<T, Alloc>& vector<T, Alloc>::operator=(const vector<T, Alloc>& x) {
+template <class T, class Alloc, class Growth>
+vector<T, Alloc, Growth>&
+vector<T, Alloc, Growth>::operator=(const vector<T, Alloc, Growth>& x) {
   //жǷΪҸֵ
   if (&x != this) 
   {
@@ -474,39 +769,32 @@ vector<T, Alloc>& vector<T, Alloc>::operator=(const vector<T, Alloc>& x) {
   return *this;
 }
 
-template <class T, class Alloc>
-void vector<T, Alloc>::insert_aux(iterator position, const T& x) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::insert_aux(iterator position, const T& x) {
   if (finish != end_of_storage) 
-  {
-    construct(finish, *(finish - 1));
-    ++finish;
-    T x_copy = x;
-    copy_backward(position, finish - 2, finish - 1);
-    *position = x_copy;
-  }
+    __vector_insert(position, finish, x, relocatable());
   else 
   {
-    const size_type old_size = size();
-    const size_type len = old_size != 0 ? 2 * old_size : 1;
+    const size_type len = next_capacity(1);
+    const size_type elems_before = position - start;
+    const T* p = &x;
+    if (reallocate_storage(len, p)) {
+      __vector_insert(start + elems_before, finish, *p, __true_type());
+      return;
+    }
     iterator new_start = data_allocator::allocate(len);
+    iterator new_position = new_start + elems_before;
     iterator new_finish = new_start;
     __STL_TRY 
-	{
-      new_finish = uninitialized_copy(start, position, new_start);
-      construct(new_finish, x);
-      ++new_finish;
-      new_finish = uninitialized_copy(position, finish, new_finish);
-    }
-
-#       ifdef  __STL_USE_EXCEPTIONS 
-    catch(...) 
     {
-      destroy(new_start, new_finish); 
-      data_allocator::deallocate(new_start, len);
-      throw;
+      construct(new_position, x);
+      __STL_TRY {
+        new_finish = relocate_around(position, new_start, 1);
+      }
+      __STL_UNWIND(destroy(new_position));
     }
-#       endif /* __STL_USE_EXCEPTIONS */
-    destroy(begin(), end());
+    __STL_UNWIND(data_allocator::deallocate(new_start, len));
+    count_reallocation();
     deallocate();
     start = new_start;
     finish = new_finish;
@@ -514,53 +802,65 @@ void vector<T, Alloc>::insert_aux(iterator position, const T& x) {
   }
 }
 
-template <class T, class Alloc>
-void vector<T, Alloc>::insert(iterator position, size_type n, const T& x) 
+template <class T, class Alloc, class Growth>
+bool vector<T, Alloc, Growth>::reallocate_storage(size_type len, const T*& p,
+                                                  __true_type, __true_type)
+{
+  const size_type old_size = size();
+  if (start == 0)
+    start = data_allocator::allocate(len);
+  else
+  {
+    const bool p_inside = p >= start && p < finish;
+    const size_type p_index = p_inside ? p - start : 0;
+    iterator tmp = (iterator) Alloc::reallocate(start,
+                                                capacity() * sizeof(T),
+                                                len * sizeof(T));
+    if (tmp == 0) {             // realloc failed; start is still valid
+      __THROW_BAD_ALLOC;
+    }
+    if (tmp != start)           // the block moved, and the elements with it
+      count_reallocation();
+    start = tmp;
+    if (p_inside)
+      p = start + p_index;
+  }
+  finish = start + old_size;
+  end_of_storage = start + len;
+  return true;
+}
+
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::insert(iterator position, size_type n,
+                                      const T& x)
 {
   if (n != 0) 
   {
     if (size_type(end_of_storage - finish) >= n) 
-	{
-      T x_copy = x;
-      const size_type elems_after = finish - position;
-      iterator old_finish = finish;
-      if (elems_after > n) 
-	  {
-        uninitialized_copy(finish - n, finish, finish);
-        finish += n;
-        copy_backward(position, old_finish - n, old_finish);
-        fill(position, position + n, x_copy);
-      }
-      else 
-	  {
-        uninitialized_fill_n(finish, n - elems_after, x_copy);
-        finish += n - elems_after;
-        uninitialized_copy(position, old_finish, finish);
-        finish += elems_after;
-        fill(position, old_finish, x_copy);
-      }
-    }
+      __vector_fill_insert(position, finish, n, x, relocatable());
     else 
-	{
-      const size_type old_size = size();        
-      const size_type len = old_size + max(old_size, n);
+    {
+      const size_type len = next_capacity(n);
+      const size_type elems_before = position - start;
+      const T* p = &x;
+      if (reallocate_storage(len, p)) {
+        __vector_fill_insert(start + elems_before, finish, n, *p,
+                             __true_type());
+        return;
+      }
       iterator new_start = data_allocator::allocate(len);
+      iterator new_position = new_start + elems_before;
       iterator new_finish = new_start;
       __STL_TRY 
-	  {
-        new_finish = uninitialized_copy(start, position, new_start);
-        new_finish = uninitialized_fill_n(new_finish, n, x);
-        new_finish = uninitialized_copy(position, finish, new_finish);
-      }
-#         ifdef  __STL_USE_EXCEPTIONS 
-      catch(...) 
       {
-        destroy(new_start, new_finish);
-        data_allocator::deallocate(new_start, len);
-        throw;
+        uninitialized_fill_n(new_position, n, x);
+        __STL_TRY {
+          new_finish = relocate_around(position, new_start, n);
+        }
+        __STL_UNWIND(destroy(new_position, new_position + n));
       }
-#         endif /* __STL_USE_EXCEPTIONS */
-      destroy(start, finish);
+      __STL_UNWIND(data_allocator::deallocate(new_start, len));
+      count_reallocation();
       deallocate();
       start = new_start;
       finish = new_finish;
@@ -571,10 +871,11 @@ void vector<T, Alloc>::insert(iterator position, size_type n, const T& x)
 
 #ifdef __STL_MEMBER_TEMPLATES
 
-template <class T, class Alloc> template <class InputIterator>
-void vector<T, Alloc>::range_insert(iterator pos,
-                                    InputIterator first, InputIterator last,
-                                    input_iterator_tag)
+template <class T, class Alloc, class Growth> template <class InputIterator>
+void vector<T, Alloc, Growth>::range_insert(iterator pos,
+                                            InputIterator first,
+                                            InputIterator last,
+                                            input_iterator_tag)
 {
   for ( ; first != last; ++first) 
   {
@@ -583,59 +884,42 @@ void vector<T, Alloc>::range_insert(iterator pos,
   }
 }
 
-template <class T, class Alloc> template <class ForwardIterator>
-void vector<T, Alloc>::range_insert(iterator position,
-                                    ForwardIterator first,
-                                    ForwardIterator last,
-                                    forward_iterator_tag) 
+template <class T, class Alloc, class Growth> template <class ForwardIterator>
+void vector<T, Alloc, Growth>::range_insert(iterator position,
+                                            ForwardIterator first,
+                                            ForwardIterator last,
+                                            forward_iterator_tag) 
 {
   if (first != last) 
   {
     size_type n = 0;
     distance(first, last, n);
     if (size_type(end_of_storage - finish) >= n) 
-	{
-      const size_type elems_after = finish - position;
-      iterator old_finish = finish;
-      if (elems_after > n) 
-	  {
-        uninitialized_copy(finish - n, finish, finish);
-        finish += n;
-        copy_backward(position, old_finish - n, old_finish);
-        copy(first, last, position);
-      }
-      else 
-	  {
-        ForwardIterator mid = first;
-        advance(mid, elems_after);
-        uninitialized_copy(mid, last, finish);
-        finish += n - elems_after;
-        uninitialized_copy(position, old_finish, finish);
-        finish += elems_after;
-        copy(first, mid, position);
-      }
-    }
+      __vector_range_insert(position, finish, first, last, n,
+                            relocatable());
     else 
-	{
-      const size_type old_size = size();
-      const size_type len = old_size + max(old_size, n);
+    {
+      const size_type len = next_capacity(n);
+      const size_type elems_before = position - start;
+      const T* none = 0;
+      if (reallocate_storage(len, none)) {
+        __vector_range_insert(start + elems_before, finish, first, last, n,
+                              __true_type());
+        return;
+      }
       iterator new_start = data_allocator::allocate(len);
+      iterator new_position = new_start + elems_before;
       iterator new_finish = new_start;
       __STL_TRY 
-	  {
-        new_finish = uninitialized_copy(start, position, new_start);
-        new_finish = uninitialized_copy(first, last, new_finish);
-        new_finish = uninitialized_copy(position, finish, new_finish);
-      }
-#         ifdef __STL_USE_EXCEPTIONS
-      catch(...) 
       {
-        destroy(new_start, new_finish);
-        data_allocator::deallocate(new_start, len);
-        throw;
+        uninitialized_copy(first, last, new_position);
+        __STL_TRY {
+          new_finish = relocate_around(position, new_start, n);
+        }
+        __STL_UNWIND(destroy(new_position, new_position + n));
       }
-#         endif /* __STL_USE_EXCEPTIONS */
-      destroy(start, finish);
+      __STL_UNWIND(data_allocator::deallocate(new_start, len));
+      count_reallocation();
       deallocate();
       start = new_start;
       finish = new_finish;
@@ -646,55 +930,41 @@ void vector<T, Alloc>::range_insert(iterator position,
 
 #else /* __STL_MEMBER_TEMPLATES */
 
-template <class T, class Alloc>
-void vector<T, Alloc>::insert(iterator position, 
-                              const_iterator first, 
-                              const_iterator last) 
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::insert(iterator position, 
+                                      const_iterator first, 
+                                      const_iterator last) 
 {
   if (first != last) 
   {
     size_type n = 0;
     distance(first, last, n);
     if (size_type(end_of_storage - finish) >= n) 
-	{
-      const size_type elems_after = finish - position;
-      iterator old_finish = finish;
-      if (elems_after > n) {
-        uninitialized_copy(finish - n, finish, finish);
-        finish += n;
-        copy_backward(position, old_finish - n, old_finish);
-        copy(first, last, position);
-      }
-      else 
-	  {
-        uninitialized_copy(first + elems_after, last, finish);
-        finish += n - elems_after;
-        uninitialized_copy(position, old_finish, finish);
-        finish += elems_after;
-        copy(first, first + elems_after, position);
-      }
-    }
+      __vector_range_insert(position, finish, first, last, n,
+                            relocatable());
     else 
-	{
-      const size_type old_size = size();
-      const size_type len = old_size + max(old_size, n);
+    {
+      const size_type len = next_capacity(n);
+      const size_type elems_before = position - start;
+      const T* none = 0;
+      if (reallocate_storage(len, none)) {
+        __vector_range_insert(start + elems_before, finish, first, last, n,
+                              __true_type());
+        return;
+      }
       iterator new_start = data_allocator::allocate(len);
+      iterator new_position = new_start + elems_before;
       iterator new_finish = new_start;
       __STL_TRY 
-	  {
-        new_finish = uninitialized_copy(start, position, new_start);
-        new_finish = uninitialized_copy(first, last, new_finish);
-        new_finish = uninitialized_copy(position, finish, new_finish);
-      }
-#         ifdef __STL_USE_EXCEPTIONS
-      catch(...) 
       {
-        destroy(new_start, new_finish);
-        data_allocator::deallocate(new_start, len);
-        throw;
+        uninitialized_copy(first, last, new_position);
+        __STL_TRY {
+          new_finish = relocate_around(position, new_start, n);
+        }
+        __STL_UNWIND(destroy(new_position, new_position + n));
       }
-#         endif /* __STL_USE_EXCEPTIONS */
-      destroy(start, finish);
+      __STL_UNWIND(data_allocator::deallocate(new_start, len));
+      count_reallocation();
       deallocate();
       start = new_start;
       finish = new_finish;
@@ -711,6 +981,15 @@ void vector<T, Alloc>::insert(iterator position,
 
 __STL_END_NAMESPACE 
 
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+
+template <class T, class Alloc, class Growth>
+struct __relocate_traits<__STD::vector<T, Alloc, Growth> > {
+  typedef __true_type is_trivially_relocatable;
+};
+
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
 #endif /* __SGI_STL_INTERNAL_VECTOR_H */
 
 // Local Variables:
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 1997
+ * Silicon Graphics Computer Systems, Inc.
+ *
+ * Permission to use, copy, modify, distribute and sell this software
+ * and its documentation for any purpose is hereby granted without fee,
+ * provided that the above copyright notice appear in all copies and
+ * that both that copyright notice and this permission notice appear
+ * in supporting documentation.  Silicon Graphics makes no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ */
+
+/* NOTE: This is an internal header file, included by other STL headers.
+ *   You should not attempt to use it directly.
+ */
+
+#ifndef __SGI_STL_INTERNAL_WORK_STEALING_DEQUE_H
+#define __SGI_STL_INTERNAL_WORK_STEALING_DEQUE_H
+
+/*
+
+Work-stealing deque, after Chase and Lev, for task schedulers.
+
+One thread, the owner, pushes and pops at the bottom end; any number of
+other threads, the thieves, take from the top end.  So the owner works
+through its own tasks last in, first out, while thieves take the oldest
+ones, which in a fork-join computation are the largest.
+
+The owner's push is a load and a release store; its pop adds a fence,
+and needs a compare-and-swap only when it and the thieves compete for
+the last element.  A steal is a compare-and-swap on the top index, and
+fails, so that the thief tries elsewhere, when it loses the element to
+the owner or another thief.  The two indices are kept on cache lines
+of their own.
+
+The elements are in a circular array whose size is a power of two.
+When it is full the owner copies them into one twice the size.  Thieves
+may still be reading the old array, so it is only freed along with the
+deque.
+
+The element type must be a POD, typically a pointer to a task or a
+small struct describing one: elements are copied by assignment while
+thieves may be reading them, and are never constructed or destroyed.
+size() is only a snapshot while other threads are using the deque.
+
+*/
+
+__STL_BEGIN_NAMESPACE
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma set woff 1174
+#endif
+
+template <class T>
+struct __work_stealing_array {
+  size_t mask;
+  T* slots;
+  __work_stealing_array<T>* retired;    // the array this one replaced
+};
+
+template <class T, class Alloc = alloc>
+class work_stealing_deque {
+public:
+  typedef T value_type;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+protected:
+  typedef __work_stealing_array<T> array;
+  typedef simple_alloc<array, Alloc> array_allocator;
+  typedef simple_alloc<T, Alloc> slot_allocator;
+
+  char pad0[__STL_CACHE_LINE_SIZE];
+  volatile size_type top;
+  char pad1[__STL_CACHE_LINE_SIZE];
+  volatile size_type bottom;
+  volatile size_type current;   // the array in use
+  char pad2[__STL_CACHE_LINE_SIZE];
+
+  static array* allocate_array(size_type n) {
+    array* a = array_allocator::allocate();
+    __STL_TRY {
+      a->slots = slot_allocator::allocate(n);
+    }
+    __STL_UNWIND(array_allocator::deallocate(a));
+    a->mask = n - 1;
+    a->retired = 0;
+    return a;
+  }
+  array* grow(array* a, size_type t, size_type b);
+
+private:
+  work_stealing_deque(const work_stealing_deque<T, Alloc>&);
+  work_stealing_deque<T, Alloc>&
+  operator=(const work_stealing_deque<T, Alloc>&);
+
+public:
+  explicit work_stealing_deque(size_type n = 256);
+  ~work_stealing_deque();
+
+  size_type capacity() const {
+    return ((array*) __stl_atomic_load(&current))->mask + 1;
+  }
+  size_type size() const {
+    const size_type t = __stl_atomic_load(&top);
+    const size_type b = __stl_atomic_load(&bottom);
+    return difference_type(b - t) <= 0 ? 0 : b - t;
+  }
+  bool empty() const { return size() == 0; }
+
+  // Owner only.
+  void push(const T& x) {
+    const size_type b = bottom;
+    const size_type t = __stl_atomic_load(&top);
+    array* a = (array*) current;
+    if (b - t > a->mask)
+      a = grow(a, t, b);
+    a->slots[b & a->mask] = x;
+    __stl_atomic_store(&bottom, b + 1);
+  }
+  // Owner only: takes the element pushed last.
+  bool try_pop(T& x) {
+    const size_type b = bottom - 1;
+    array* a = (array*) current;
+    __stl_atomic_store(&bottom, b);
+    __stl_atomic_fence();
+    const size_type t = __stl_atomic_load(&top);
+    if (difference_type(b - t) < 0) {
+      __stl_atomic_store(&bottom, b + 1);
+      return false;
+    }
+    const T value = a->slots[b & a->mask];
+    if (b == t) {               // the last one: a thief may take it first
+      const bool won = __stl_atomic_compare_and_swap(&top, t, t + 1);
+      __stl_atomic_store(&bottom, b + 1);
+      if (!won)
+        return false;
+    }
+    x = value;
+    return true;
+  }
+  // Any thread: takes the element pushed first.
+  bool try_steal(T& x) {
+    const size_type t = __stl_atomic_load(&top);
+    __stl_atomic_fence();
+    const size_type b = __stl_atomic_load(&bottom);
+    if (difference_type(b - t) <= 0)
+      return false;
+    array* a = (array*) __stl_atomic_load(&current);
+    const T value = a->slots[t & a->mask];
+    if (!__stl_atomic_compare_and_swap(&top, t, t + 1))
+      return false;
+    x = value;
+    return true;
+  }
+};
+
+template <class T, class Alloc>
+work_stealing_deque<T, Alloc>::work_stealing_deque(size_type n)
+  : top(0), bottom(0)
+{
+  size_type cap = 1;
+  while (cap < n)
+    cap *= 2;
+  current = (size_type) allocate_array(cap);
+}
+
+template <class T, class Alloc>
+work_stealing_deque<T, Alloc>::~work_stealing_deque()
+{
+  array* a = (array*) current;
+  while (a) {
+    array* next = a->retired;
+    slot_allocator::deallocate(a->slots, a->mask + 1);
+    array_allocator::deallocate(a);
+    a = next;
+  }
+}
+
+// Copies the elements in [t, b) of a into an array twice its size and
+// makes that the current one.
+template <class T, class Alloc>
+typename work_stealing_deque<T, Alloc>::array*
+work_stealing_deque<T, Alloc>::grow(array* a, size_type t, size_type b)
+{
+  array* n = allocate_array(2 * (a->mask + 1));
+  for (size_type i = t; i != b; ++i)
+    n->slots[i & n->mask] = a->slots[i & a->mask];
+  n->retired = a;
+  __stl_atomic_store(&current, (size_type) n);
+  return n;
+}
+
+#if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
+#pragma reset woff 1174
+#endif
+
+__STL_END_NAMESPACE
+
+#endif /* __SGI_STL_INTERNAL_WORK_STEALING_DEQUE_H */
+
+// Local Variables:
+// mode:C++
+// End:
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 1997
+ * Silicon Graphics Computer Systems, Inc.
+ *
+ * Permission to use, copy, modify, distribute and sell this software
+ * and its documentation for any purpose is hereby granted without fee,
+ * provided that the above copyright notice appear in all copies and
+ * that both that copyright notice and this permission notice appear
+ * in supporting documentation.  Silicon Graphics makes no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ */
+
+#ifndef __SGI_STL_THREAD_POOL_H
+#define __SGI_STL_THREAD_POOL_H
+
+#include <algobase.h>
+#include <alloc.h>
+#include <stl_atomic.h>
+#include <stl_bounded_queue.h>
+#include <stl_work_stealing_deque.h>
+#include <stl_thread_pool.h>
+
+#ifdef __STL_USE_NAMESPACES
+using __STD::work_stealing_deque;
+#ifdef __STL_PTHREADS
+using __STD::thread_pool;
+using __STD::task_group;
+#endif /* __STL_PTHREADS */
+#endif /* __STL_USE_NAMESPACES */
+
+#endif /* __SGI_STL_THREAD_POOL_H */
+
+// Local Variables:
+// mode:C++
+// End:
@@ -226,6 +226,30 @@ struct __type_traits<unsigned char*> {
 #endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
 
 
+/*
+__relocate_traits<T>::is_trivially_relocatable is __true_type if an
+object of type T can be moved to a new address by copying its bytes
+and then treating the old bytes as raw storage, without running the
+copy constructor or the destructor.  Containers use this when they
+move elements between buffers.
+
+Every POD type qualifies, which is the default.  The STL containers
+also qualify, since none of them keeps a pointer to itself; their
+headers provide the specializations.  You may specialize
+__relocate_traits in the same way for a class of your own.  A class
+that keeps its own address, or the address of one of its members,
+must not be marked.
+
+__relocate_traits is kept separate from __type_traits so that existing
+specializations of __type_traits remain complete.
+*/
+
+template <class type>
+struct __relocate_traits {
+   typedef typename __type_traits<type>::is_POD_type is_trivially_relocatable;
+};
+
+
 #endif /* __TYPE_TRAITS_H */
 
 // Local Variables:
@@ -33,6 +33,10 @@
 
 #ifdef __STL_USE_NAMESPACES
 using __STD::vector;
+using __STD::vector_growth_2x;
+using __STD::vector_growth_1_5x;
+using __STD::vector_growth_page;
+using __STD::vector_growth_usable;
 #endif /* __STL_USE_NAMESPACES */
 
 #endif /* __SGI_STL_VECTOR_H */